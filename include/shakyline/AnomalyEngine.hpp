@@ -1,12 +1,22 @@
 #pragma once
 
 #include "shakyline/Config.hpp"
+#include "shakyline/DecisionPlan.hpp"
 #include "shakyline/DeterministicRng.hpp"
+#include <algorithm>
 #include <chrono>
 #include <cstdint>
 #include <span>
 #include <vector>
 
+// AVX2 batch path: compiled per function with a target attribute, selected
+// at runtime, so the binary still runs on CPUs without it
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SHAKYLINE_HAVE_AVX2_DISPATCH 1
+#else
+#define SHAKYLINE_HAVE_AVX2_DISPATCH 0
+#endif
+
 namespace shakyline {
 
 /// Direction of traffic flow
@@ -29,25 +39,59 @@ struct AnomalyDecision {
     };
 
     Action action = Action::Forward;
-    uint32_t delayMs = 0;
+    uint32_t delayUs = 0;
+    uint32_t stallMs = 0;
     uint32_t throttleBytesPerSec = 0;
     std::size_t corruptOffset = 0;
     uint8_t corruptMask = 0;
 };
 
+/// Per-direction state that decisions carry from packet to packet
+/// Owned by the caller and fed back into every decision for that direction
+struct DecisionState {
+    bool burstBad = false;         // Gilbert-Elliott state
+    float delayDeviation = 0.0f;   // Last jitter, in DelayTable units (AR(1))
+};
+
+/// One packet of a decideBatch() call
+struct DecisionInput {
+    uint64_t sessionId;
+    uint64_t packetSeq;
+    uint32_t length;  // Payload bytes (corruption offset range)
+    Direction direction;
+    DecisionState* state = nullptr;  // Needed for burst loss / correlated delay
+};
+
 /// Stateless anomaly decision engine
 /// Uses deterministic RNG for reproducible fault injection
 class AnomalyEngine {
 public:
-    explicit AnomalyEngine(uint64_t globalSeed) : globalSeed_(globalSeed) {}
+    /// Stall durations never exceed maxStall (ServerConfig::stallTimeout)
+    explicit AnomalyEngine(uint64_t globalSeed,
+                           std::chrono::milliseconds maxStall = std::chrono::milliseconds(30000))
+        : globalSeed_(globalSeed)
+        , maxStallMs_(static_cast<uint32_t>(std::max<int64_t>(1, maxStall.count()))) {}
 
-    /// Make an anomaly decision for a packet
+    /// Make an anomaly decision for a packet under a compiled profile
+    /// `state` advances one step per call; without it burst loss is skipped
+    /// and delays are uncorrelated
     AnomalyDecision decide(
         std::span<const uint8_t> data,
         Direction direction,
         uint64_t sessionId,
         uint64_t packetSeq,
-        const AnomalyProfile& profile
+        const DecisionPlan& plan,
+        DecisionState* state = nullptr
+    ) const;
+
+    /// decide() for many packets under one plan, bit-identical to calling it
+    /// per packet. Hashes are computed four packets at a time with AVX2 where
+    /// the CPU has it (checked at runtime), else one by one.
+    /// `out` must hold at least inputs.size() decisions.
+    void decideBatch(
+        std::span<const DecisionInput> inputs,
+        const DecisionPlan& plan,
+        std::span<AnomalyDecision> out
     ) const;
 
     /// Apply corruption to data (modifies in place)
@@ -62,11 +106,14 @@ public:
 
 private:
     uint64_t globalSeed_;
+    uint32_t maxStallMs_;
 
-    const DirectionalProfile& getDirectionalProfile(
-        Direction direction,
-        const AnomalyProfile& profile
-    ) const;
+    void decideBatchScalar(std::span<const DecisionInput> inputs, const DecisionPlan& plan,
+                           std::span<AnomalyDecision> out) const;
+#if SHAKYLINE_HAVE_AVX2_DISPATCH
+    void decideBatchAvx2(std::span<const DecisionInput> inputs, const DecisionPlan& plan,
+                         std::span<AnomalyDecision> out) const;
+#endif
 };
 
 } // namespace shakyline
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <asio.hpp>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <vector>
@@ -8,20 +9,28 @@
 
 namespace shakyline {
 
-/// Ring buffer with high/low watermarks for flow control
+/// Wraparound ring buffer with high/low watermarks for flow control
+/// Bytes never move once written; readable data is at most two segments.
+/// Storage is borrowed from the thread's BufferPool only while data is in
+/// flight: an idle buffer holds no memory, and it grows through the pool's
+/// size classes up to its capacity.
 class Buffer {
 public:
+    /// Readable data as (up to) two segments for a single gathering write
+    using ConstBuffers = std::array<asio::const_buffer, 2>;
+
     static constexpr std::size_t DEFAULT_CAPACITY = 64 * 1024;  // 64KB
     static constexpr std::size_t HIGH_WATERMARK = 48 * 1024;    // 48KB
     static constexpr std::size_t LOW_WATERMARK = 16 * 1024;     // 16KB
 
     explicit Buffer(std::size_t capacity = DEFAULT_CAPACITY);
+    ~Buffer();
 
     // Non-copyable, movable
     Buffer(const Buffer&) = delete;
     Buffer& operator=(const Buffer&) = delete;
-    Buffer(Buffer&&) noexcept = default;
-    Buffer& operator=(Buffer&&) noexcept = default;
+    Buffer(Buffer&& other) noexcept;
+    Buffer& operator=(Buffer&& other) noexcept;
 
     /// Current readable bytes
     std::size_t readable() const noexcept { return size_; }
@@ -29,9 +38,18 @@ public:
     /// Available space for writing
     std::size_t writable() const noexcept { return capacity_ - size_; }
 
+    /// Space append() takes in full right now: while a write is in flight
+    /// the storage is pinned and cannot grow towards capacity
+    std::size_t appendable() const noexcept {
+        return sending_ ? std::min(capacity_, storageSize_) - size_ : writable();
+    }
+
     /// Total capacity
     std::size_t capacity() const noexcept { return capacity_; }
 
+    /// Bytes of pooled storage currently held (0 when idle)
+    std::size_t storageBytes() const noexcept { return storageSize_; }
+
     /// Is buffer empty?
     bool empty() const noexcept { return size_ == 0; }
 
@@ -53,33 +71,48 @@ public:
     std::size_t append(const uint8_t* data, std::size_t len);
 
     /// Consume data from buffer front
-    /// Returns bytes actually consumed
+    /// Returns bytes actually consumed; storage goes back to the pool on drain
     std::size_t consume(std::size_t len);
 
     /// Peek at front data without consuming
-    /// Returns number of contiguous bytes available
+    /// Returns number of contiguous bytes available (first segment only)
     std::size_t peek(const uint8_t** outData) const noexcept;
 
-    /// Get asio mutable buffer for async_read
+    /// Get contiguous free space at the tail for a read
+    /// May be shorter than maxBytes where the ring wraps
     asio::mutable_buffer prepareWrite(std::size_t maxBytes);
 
     /// Commit bytes written via prepareWrite
     void commitWrite(std::size_t bytesWritten);
 
-    /// Get asio const buffer for async_write
-    asio::const_buffer dataToSend() const;
+    /// Get readable data for async_write (second segment empty unless wrapped)
+    /// Storage is pinned (never regrown) until the next consume()
+    ConstBuffers dataToSend();
+
+    /// Return storage to the pool if nothing is buffered
+    /// (e.g. after a read was dropped and its prepareWrite space rolled back)
+    void trim() noexcept;
 
     /// Clear all data
     void clear() noexcept;
 
 private:
-    std::vector<uint8_t> data_;
+    uint8_t* data_ = nullptr;
+    std::size_t storageSize_ = 0;
     std::size_t capacity_;
     std::size_t readPos_ = 0;
-    std::size_t writePos_ = 0;
     std::size_t size_ = 0;
+    bool sending_ = false;
+
+    /// Ensure storage can hold `needed` bytes in total (false if pinned/maxed)
+    bool reserve(std::size_t needed);
+    void releaseStorage() noexcept;
 
-    void compact();
+    /// Offset one past the last readable byte
+    std::size_t tailPos() const noexcept {
+        std::size_t pos = readPos_ + size_;
+        return pos >= storageSize_ ? pos - storageSize_ : pos;
+    }
 };
 
 } // namespace shakyline
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace shakyline {
+
+/// Size-classed free lists for session buffer storage
+/// One pool per thread, i.e. one per event loop shard: no locking needed.
+/// Blocks released on another thread simply join that thread's pool.
+class BufferPool {
+public:
+    static constexpr std::array<std::size_t, 3> SIZE_CLASSES = {
+        4 * 1024, 16 * 1024, 64 * 1024
+    };
+    static constexpr std::size_t MAX_CACHED_PER_CLASS = 1024;
+
+    BufferPool() = default;
+    ~BufferPool();
+
+    // Non-copyable
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /// Pool for the calling thread
+    static BufferPool& local();
+
+    /// Get a block of at least minSize bytes; actual size is the class size
+    /// (requests above the largest class are allocated exactly)
+    uint8_t* acquire(std::size_t minSize, std::size_t& actualSize);
+
+    /// Return a block obtained from acquire() with its actual size
+    void release(uint8_t* block, std::size_t size) noexcept;
+
+    /// Blocks currently cached (all classes)
+    std::size_t cachedBlocks() const noexcept;
+
+private:
+    static int classIndex(std::size_t size) noexcept;
+
+    std::array<std::vector<uint8_t*>, SIZE_CLASSES.size()> freeLists_;
+};
+
+} // namespace shakyline
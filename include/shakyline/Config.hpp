@@ -3,23 +3,63 @@
 #include <atomic>
 #include <chrono>
 #include <cstdint>
+#include <memory>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 
 namespace shakyline {
 
+/// Shape of the jitter added to latency (netem's delay distributions)
+enum class DelayDistribution : uint8_t {
+    Uniform,      // latency ± jitter, flat
+    Normal,       // jitter is the standard deviation
+    Pareto,       // Heavy right tail (alpha 3), standardized like Normal
+    ParetoNormal  // 1/4 normal + 3/4 Pareto, standardized
+};
+
 /// Directional anomaly profile (one direction of traffic)
 struct DirectionalProfile {
     uint32_t latencyMs = 0;
     uint32_t jitterMs = 0;
+    uint32_t latencyUs = 0;  // Added to latencyMs; any _us field selects the
+    uint32_t jitterUs = 0;   // microsecond path (precise release, µs jitter)
+    DelayDistribution delayDistribution = DelayDistribution::Uniform;
+    float delayCorrelation = 0.0f;  // AR(1) coefficient between consecutive jitters
+    std::string delayTrace;  // Uploaded LatencyTrace to draw delays from (replaces jitter)
     uint32_t throttleKbps = 0;
     float dropRate = 0.0f;
+    // Gilbert-Elliott burst loss: per-packet good->bad (p) and bad->good (r)
+    // transition rates, and loss probability while in each state
+    float burstEnterRate = 0.0f;
+    float burstExitRate = 0.0f;
+    float burstLossGood = 0.0f;
+    float burstLossBad = 0.0f;
     float stallProbability = 0.0f;
+    uint32_t stallMs = 0;  // Longest stall; 0 = up to the server's stallTimeout
     float corruptRate = 0.0f;
     float reorderRate = 0.0f;
+    uint32_t reorderDistance = 1;  // Later segments sent ahead of a reordered one
     float halfCloseRate = 0.0f;
+
+    /// True if any fault is configured for this direction
+    bool hasFaults() const noexcept {
+        return latencyMs != 0 || jitterMs != 0 || preciseLatency() || throttleKbps != 0 ||
+               dropRate > 0.0f || burstLoss() || stallProbability > 0.0f || corruptRate > 0.0f ||
+               reorderRate > 0.0f || halfCloseRate > 0.0f;
+    }
+
+    /// True if the Gilbert-Elliott loss model can drop anything
+    bool burstLoss() const noexcept {
+        return burstLossGood > 0.0f || (burstEnterRate > 0.0f && burstLossBad > 0.0f);
+    }
+
+    /// True if latency is specified at microsecond resolution
+    bool preciseLatency() const noexcept {
+        return latencyUs != 0 || jitterUs != 0 || !delayTrace.empty();
+    }
 };
 
 /// Complete anomaly profile with bidirectional settings
@@ -33,6 +73,12 @@ struct AnomalyProfile {
 struct ConfigLimits {
     static constexpr uint32_t MAX_LATENCY_MS = 30000;
     static constexpr uint32_t MAX_JITTER_MS = 10000;
+    static constexpr uint32_t MAX_LATENCY_US = 1000000;  // Fine part; ms fields add on
+    static constexpr uint32_t MAX_JITTER_US = 1000000;
+    static constexpr uint32_t MAX_DELAY_MS = MAX_LATENCY_MS + MAX_JITTER_MS;  // Shaped/trace cap
+    static constexpr uint32_t MAX_JITTER_DEVIATIONS = 10;  // Shaped jitter: base + 10 * jitter
+    static constexpr uint32_t MAX_REORDER_DISTANCE = 64;
+    static constexpr uint32_t MAX_REORDER_HOLD_MS = 1000;  // Held segment goes anyway
     static constexpr uint32_t MAX_THROTTLE_KBPS = 1000000;  // 1 Gbps
     static constexpr float MAX_RATE = 1.0f;
     static constexpr std::size_t MAX_BUFFER_BYTES = 4 * 1024 * 1024;  // 4MB
@@ -41,6 +87,21 @@ struct ConfigLimits {
     static constexpr int CONFIG_UPDATE_RATE_LIMIT = 10;  // per second
 };
 
+/// How accepted connections are spread across event loop shards
+enum class AcceptMode : uint8_t {
+    ReusePort,  // Every shard accepts; kernel hashes connections (SO_REUSEPORT)
+    Balanced    // Shard 0 accepts and hands each socket to the least-loaded shard
+};
+
+/// Requested socket I/O backend
+/// Asio fixes its reactor at compile time (SHAKYLINE_IO_URING); this only selects
+/// among what the binary supports and is checked against the kernel at startup
+enum class IoBackend : uint8_t {
+    Auto,
+    Epoll,
+    IoUring
+};
+
 /// Server configuration
 struct ServerConfig {
     std::string listenHost = "0.0.0.0";
@@ -49,6 +110,12 @@ struct ServerConfig {
     uint16_t upstreamPort = 9000;
     uint16_t controlPort = 9090;
     uint64_t globalSeed = 0;
+    std::size_t ioThreads = 1;  // Event loop shards
+    AcceptMode acceptMode = AcceptMode::ReusePort;
+    IoBackend ioBackend = IoBackend::Auto;
+    std::string delaySpillDir;  // Empty = delayed data never leaves memory
+    std::size_t delaySpillMaxBytes = 256 * 1024 * 1024;  // Per loop thread
+    std::string traceDir;  // Empty = uploaded latency traces live in memory only
     
     std::chrono::milliseconds connectTimeout{5000};
     std::chrono::milliseconds idleTimeout{60000};
@@ -57,6 +124,9 @@ struct ServerConfig {
     std::chrono::milliseconds maxLingerTimeout{120000};
 };
 
+struct DecisionPlan;
+class LatencyTrace;
+
 /// Thread-safe configuration manager
 class ConfigManager {
 public:
@@ -65,12 +135,31 @@ public:
     /// Get a profile by name (returns default if not found)
     AnomalyProfile getProfile(const std::string& name) const;
 
+    /// Compiled plan of a profile (the no-fault plan if not found)
+    std::shared_ptr<const DecisionPlan> getPlan(const std::string& name) const;
+
     /// Set a profile (returns new version)
     uint32_t setProfile(const std::string& name, AnomalyProfile profile);
 
     /// Delete a profile
     bool deleteProfile(const std::string& name);
 
+    /// Compile uploaded latency samples into a trace (see LatencyTrace::build),
+    /// stored under serverConfig().traceDir if set; profiles naming the trace
+    /// switch to it. Returns the sample count; throws on bad names or samples.
+    uint64_t setTrace(const std::string& name, std::string_view samples);
+
+    /// Delete a trace; profiles already using it keep it until they are set again
+    bool deleteTrace(const std::string& name);
+
+    /// Map the trace files in serverConfig().traceDir (returns how many)
+    std::size_t loadTraces();
+
+    /// Bumped on every profile set/delete; sessions poll it to refresh
+    uint64_t generation() const noexcept { 
+        return generation_.load(std::memory_order_acquire); 
+    }
+
     /// Check rate limit for config updates
     bool checkRateLimit();
 
@@ -82,9 +171,18 @@ public:
     static DirectionalProfile validate(const DirectionalProfile& profile);
 
 private:
+    /// Compile with the profile's traces resolved; writeMutex_ must be held
+    std::shared_ptr<const DecisionPlan> compile(const AnomalyProfile& profile) const;
+
     mutable std::shared_mutex mutex_;
-    std::unordered_map<std::string, AnomalyProfile> profiles_;
+    std::unordered_map<std::string, std::shared_ptr<const DecisionPlan>> profiles_;
+
+    // Writers (profile and trace updates) serialize here and compile without
+    // holding mutex_, so readers only wait for the final swap
+    std::mutex writeMutex_;
+    std::unordered_map<std::string, std::shared_ptr<const LatencyTrace>> traces_;
     std::atomic<uint32_t> nextVersion_{1};
+    std::atomic<uint64_t> generation_{0};
     
     std::mutex rateMutex_;
     std::chrono::steady_clock::time_point lastUpdate_;
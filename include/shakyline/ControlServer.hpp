@@ -8,6 +8,7 @@
 #include <atomic>
 #include <memory>
 #include <thread>
+#include <vector>
 
 namespace shakyline {
 
@@ -16,7 +17,7 @@ class ControlServer {
 public:
     ControlServer(
         ConfigManager& config,
-        SessionManager::Ptr sessionManager,
+        std::vector<SessionManager::Ptr> sessionManagers,
         uint16_t port
     );
 
@@ -49,13 +50,15 @@ private:
     std::string handleGetSessions();
     std::string handlePostProfile(const std::string& name, const std::string& body);
     std::string handleDeleteProfile(const std::string& name);
+    std::string handlePostTrace(const std::string& name, const std::string& body);
+    std::string handleDeleteTrace(const std::string& name);
 
     std::string makeResponse(int status, const std::string& contentType, 
                              const std::string& body);
     std::string parseJson(const std::string& json, const std::string& key);
 
     ConfigManager& config_;
-    SessionManager::Ptr sessionManager_;
+    std::vector<SessionManager::Ptr> sessionManagers_;  // One per shard
     uint16_t port_;
 
     asio::io_context io_;
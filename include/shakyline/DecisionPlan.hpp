@@ -0,0 +1,116 @@
+#pragma once
+
+#include "shakyline/Config.hpp"
+#include "shakyline/DelayTable.hpp"
+#include "shakyline/LatencyTrace.hpp"
+
+#include <cstdint>
+#include <memory>
+
+namespace shakyline {
+
+/// Exact h % d by multiplication, for a divisor fixed ahead of time
+/// (Lemire et al., "Faster Remainder by Direct Computation"); falls back to
+/// the divide where the compiler has no 128-bit integers
+class FastMod64 {
+public:
+    explicit FastMod64(uint64_t divisor = 1) noexcept;
+
+    uint64_t operator()(uint64_t h) const noexcept {
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef unsigned __int128 u128;
+        u128 low = ((u128(mHi_) << 64) | mLo_) * h;
+        u128 bottom = (u128(static_cast<uint64_t>(low)) * d_) >> 64;
+        u128 top = (low >> 64) * d_;
+        return static_cast<uint64_t>((bottom + top) >> 64);
+#else
+        return h % d_;
+#endif
+    }
+
+private:
+    uint64_t d_;
+    uint64_t mLo_ = 0;  // ceil(2^128 / d), wrapping to 0 for d = 1
+    uint64_t mHi_ = 0;
+};
+
+/// One direction of a DecisionPlan: what AnomalyEngine::decide needs, and
+/// nothing it would otherwise recompute per packet
+struct DirectionPlan {
+    /// Enabled faults, in decision order
+    enum Fault : uint32_t {
+        DROP       = 1u << 0,
+        HALF_CLOSE = 1u << 1,
+        STALL      = 1u << 2,
+        CORRUPT    = 1u << 3,
+        REORDER    = 1u << 4,
+        DELAY      = 1u << 5,
+        THROTTLE   = 1u << 6,
+        BURST_LOSS = 1u << 7
+    };
+
+    uint32_t faults = 0;  // 0 = every packet is forwarded untouched
+
+    // Roll thresholds: fault fires when DeterministicRng::bits24(h) < threshold
+    uint32_t dropThreshold = 0;
+    uint32_t halfCloseThreshold = 0;
+    uint32_t stallThreshold = 0;
+    uint32_t corruptThreshold = 0;
+    uint32_t reorderThreshold = 0;
+
+    // Gilbert-Elliott: transition thresholds, then loss threshold per state
+    uint32_t burstEnterThreshold = 0;
+    uint32_t burstExitThreshold = 0;
+    uint32_t burstLossThreshold[2] = {0, 0};  // [good, bad]
+
+    // Delay = max(0, delayBase + jitter in [-delayJitter, delayJitter]) * delayUnitUs
+    uint32_t delayBase = 0;
+    uint32_t delayJitter = 0;
+    uint32_t delayUnitUs = 1000;  // 1 for microsecond profiles
+    FastMod64 jitterMod;          // % (2 * delayJitter + 1)
+
+    // Shaped or correlated jitter: delayJitter * deviation from the table,
+    // with deviation = delayKeep * previous + delayFresh * sample (AR(1))
+    const DelayTable* delayTable = nullptr;  // nullptr = flat jitter via jitterMod
+    float delayKeep = 0.0f;
+    float delayFresh = 1.0f;
+    uint32_t delayMax = 0;  // Cap for shaped and trace delays (tails are unbounded)
+
+    // Empirical delays: delayBase + a trace sample (µs), no jitter
+    const LatencyTrace* delayTrace = nullptr;
+
+    uint32_t stallMs = 0;
+    uint32_t throttleBytesPerSec = 0;
+};
+
+/// A profile version compiled once for the decision hot path
+/// Immutable and shared: ConfigManager builds one per setProfile() and
+/// sessions hold it until the next generation, instead of copying the profile.
+struct DecisionPlan {
+    AnomalyProfile profile;
+    DirectionPlan clientToServer;
+    DirectionPlan serverToClient;
+
+    // Keep the directions' delay traces mapped while the plan is in use
+    std::shared_ptr<const LatencyTrace> clientToServerTrace;
+    std::shared_ptr<const LatencyTrace> serverToClientTrace;
+
+    /// Traces are those the profile names (resolved by ConfigManager)
+    static std::shared_ptr<const DecisionPlan> compile(
+        const AnomalyProfile& profile,
+        std::shared_ptr<const LatencyTrace> clientToServerTrace = nullptr,
+        std::shared_ptr<const LatencyTrace> serverToClientTrace = nullptr);
+
+    /// Plan for a profile that was never set (no faults)
+    static const std::shared_ptr<const DecisionPlan>& empty();
+
+    /// Smallest t with uniform() < rate  <=>  bits24 < t (exact, as uniform()
+    /// is bits24 / 2^24 and both sides are representable)
+    static uint32_t threshold(float rate) noexcept;
+
+private:
+    static DirectionPlan compileDirection(const DirectionalProfile& profile,
+                                          const LatencyTrace* trace);
+};
+
+} // namespace shakyline
@@ -1,53 +1,90 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
-#include <queue>
+#include <memory>
+#include <optional>
+#include <span>
 #include <vector>
 
 namespace shakyline {
 
-/// Delayed packet entry with profile version binding
+class SpillStore;
+
+/// Delayed packet descriptor with profile version binding
+/// Payload bytes live in the owning DelayQueue's arena, not in the entry
 struct DelayedPacket {
-    std::vector<uint8_t> payload;
     std::chrono::steady_clock::time_point releaseTime;
     uint64_t packetSeq;
+    uint32_t chunk;      // Arena chunk holding the payload
+    uint32_t offset;     // Byte offset within that chunk
+    uint32_t length;
     uint32_t profileVersion;
     uint8_t direction;  // 0 = client->server, 1 = server->client
-
-    bool operator>(const DelayedPacket& other) const noexcept {
-        return releaseTime > other.releaseTime;
-    }
 };
 
 /// Time-ordered delay queue for fault injection
 /// Profile-version-bound: packets keep the profile active at read time
+/// Release times are clamped to be monotonic and packets kept in a ring
+/// FIFO, as a TCP byte stream cannot be overtaken by its own later bytes
+/// (the reorder fault holds a segment back via stash() instead).
+/// Payloads are bump-allocated into chunks borrowed from the loop's
+/// BufferPool; a chunk goes back to the pool once its last packet is released.
+/// Past MAX_BYTES in memory, payloads go to the loop's SpillStore (if one is
+/// configured) and are read back from the mapping at release time.
 class DelayQueue {
 public:
-    static constexpr std::size_t MAX_BYTES = 2 * 1024 * 1024;  // 2MB limit
+    static constexpr std::size_t MAX_BYTES = 2 * 1024 * 1024;  // 2MB in memory
+    static constexpr std::size_t HIGH_WATERMARK = MAX_BYTES * 3 / 4;  // 1.5MB
+    static constexpr std::size_t LOW_WATERMARK = MAX_BYTES / 4;       // 512KB
+    /// Spill headroom (per loop) below which spilling queues pause their source
+    static constexpr std::size_t SPILL_HIGH_HEADROOM = 2 * 1024 * 1024;
+    static constexpr std::size_t SPILL_LOW_HEADROOM = 8 * 1024 * 1024;
 
     DelayQueue() = default;
+    ~DelayQueue();
 
     // Non-copyable, movable
     DelayQueue(const DelayQueue&) = delete;
     DelayQueue& operator=(const DelayQueue&) = delete;
-    DelayQueue(DelayQueue&&) noexcept = default;
-    DelayQueue& operator=(DelayQueue&&) noexcept = default;
+    DelayQueue(DelayQueue&& other) noexcept;
+    DelayQueue& operator=(DelayQueue&& other) noexcept;
 
-    /// Add a delayed packet
+    /// Copy a payload into the arena (or spill tier) and queue it
     /// Returns false if queue is full (oldest will be dropped)
-    bool push(std::vector<uint8_t> payload,
+    bool push(std::span<const uint8_t> payload,
               std::chrono::steady_clock::time_point releaseTime,
               uint64_t packetSeq,
               uint32_t profileVersion,
               uint8_t direction);
 
+    /// Copy a payload into the arena without queueing it (counted in
+    /// totalBytes). Queue it later with enqueueStashed(); nullopt if too large
+    std::optional<DelayedPacket> stash(std::span<const uint8_t> payload,
+                                       uint64_t packetSeq,
+                                       uint32_t profileVersion,
+                                       uint8_t direction);
+
+    /// Queue a packet returned by stash() for release at releaseTime
+    void enqueueStashed(DelayedPacket pkt,
+                        std::chrono::steady_clock::time_point releaseTime);
+
     /// Check if any packets are ready to release
     bool hasReady(std::chrono::steady_clock::time_point now) const noexcept;
 
-    /// Pop the next ready packet (returns empty if none ready)
-    std::optional<DelayedPacket> popReady(std::chrono::steady_clock::time_point now);
+    /// Pop the next ready packet (returns empty if none ready, or if it is
+    /// longer than maxLength). Its payload stays valid until release()
+    std::optional<DelayedPacket> popReady(std::chrono::steady_clock::time_point now,
+                                          std::size_t maxLength = SIZE_MAX);
+
+    /// Payload bytes of a packet returned by popReady()
+    std::span<const uint8_t> payload(const DelayedPacket& pkt) const noexcept {
+        return {chunks_[pkt.chunk].data + pkt.offset, pkt.length};
+    }
+
+    /// Return a popped packet's payload storage to the arena
+    void release(const DelayedPacket& pkt) noexcept;
 
     /// Get time until next packet release (for scheduling)
     std::optional<std::chrono::steady_clock::time_point> nextReleaseTime() const noexcept;
@@ -55,21 +92,66 @@ public:
     /// Current total bytes queued
     std::size_t totalBytes() const noexcept { return totalBytes_; }
 
+    // --- Flow control ---
+    // Pausing the source before MAX_BYTES (or the spill budget) is reached
+    // bounds throughput by the emulated delay instead of dropping stream data.
+
+    /// Should pause reading from source?
+    bool shouldPauseReading() const noexcept {
+        return memoryBytes_ >= HIGH_WATERMARK && spillHeadroom() < SPILL_HIGH_HEADROOM;
+    }
+
+    /// Should resume reading from source?
+    bool shouldResumeReading() const noexcept {
+        return memoryBytes_ <= LOW_WATERMARK || spillHeadroom() >= SPILL_LOW_HEADROOM;
+    }
+
+    /// Queued bytes held in the spill file rather than memory
+    std::size_t spilledBytes() const noexcept { return totalBytes_ - memoryBytes_; }
+
     /// Number of packets queued
-    std::size_t size() const noexcept { return queue_.size(); }
+    std::size_t size() const noexcept { return fifoCount_; }
 
     /// Is queue empty?
-    bool empty() const noexcept { return queue_.empty(); }
+    bool empty() const noexcept { return size() == 0; }
 
-    /// Clear all delayed packets
+    /// Clear all delayed packets (popped-but-unreleased payloads included)
     void clear();
 
 private:
-    std::priority_queue<DelayedPacket, 
-                        std::vector<DelayedPacket>,
-                        std::greater<DelayedPacket>> queue_;
+    static constexpr uint32_t NO_CHUNK = UINT32_MAX;
+    static constexpr uint32_t IN_MEMORY = UINT32_MAX;
+
+    struct Chunk {
+        uint8_t* data = nullptr;    // nullptr = slot free for reuse
+        uint32_t size = 0;
+        uint32_t used = 0;          // Bump pointer
+        uint32_t live = 0;          // Packets still referencing this chunk
+        uint32_t segment = IN_MEMORY;  // Spill segment index, if spilled
+    };
+
+    // Ring FIFO (power-of-two capacity)
+    std::vector<DelayedPacket> fifo_;
+    std::size_t fifoHead_ = 0;
+    std::size_t fifoCount_ = 0;
+    std::chrono::steady_clock::time_point lastRelease_{};
+
+    std::vector<Chunk> chunks_;
+    uint32_t tailChunk_ = NO_CHUNK;     // Memory chunk new payloads go to
+    uint32_t spillTail_ = NO_CHUNK;     // Spill chunk new payloads go to
+    std::shared_ptr<SpillStore> spill_; // Taken from the loop on first spill
     std::size_t totalBytes_ = 0;
+    std::size_t memoryBytes_ = 0;
+
+    std::size_t spillHeadroom() const noexcept;
+    const DelayedPacket* front() const noexcept;
+    DelayedPacket popFront();
+    void enqueue(const DelayedPacket& pkt);
+    void unaccount(const DelayedPacket& pkt) noexcept;
 
+    uint32_t allocate(std::size_t length, bool spill, uint32_t& offset);
+    uint32_t newChunk(std::size_t length, bool spill);
+    void releaseChunk(uint32_t index) noexcept;
     void dropOldest();
 };
 
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "shakyline/Config.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace shakyline {
+
+/// Inverse-CDF table of a jitter distribution, in units of the profile's jitter
+/// SIZE quantiles taken at bin midpoints, so indexing with the top bits of a
+/// uniform 24-bit roll samples the distribution in O(1). Normal and Pareto
+/// tables are standardized (mean 0, deviation 1); the uniform one spans ±1.
+/// One immutable table per distribution, built on first use and shared.
+class DelayTable {
+public:
+    static constexpr unsigned BITS = 12;
+    static constexpr std::size_t SIZE = std::size_t(1) << BITS;
+
+    static const DelayTable& get(DelayDistribution distribution);
+
+    float sample(uint32_t bits24) const noexcept { return values_[bits24 >> (24 - BITS)]; }
+
+    float min() const noexcept { return values_.front(); }
+    float max() const noexcept { return values_.back(); }
+
+private:
+    /// Shift and scale to mean 0, deviation 1
+    void standardize();
+
+    std::array<float, SIZE> values_{};  // Ascending
+};
+
+} // namespace shakyline
@@ -20,11 +20,23 @@ public:
     /// Hash multiple values into a single seed
     static uint64_t hash(uint64_t globalSeed, uint64_t sessionId, 
                          uint64_t packetSeq, uint8_t direction) noexcept {
-        uint64_t h = globalSeed;
-        h = splitmix64(h ^ sessionId);
-        h = splitmix64(h ^ packetSeq);
-        h = splitmix64(h ^ direction);
-        return h;
+        return hashFrom(sessionKey(globalSeed, sessionId), packetSeq, direction);
+    }
+
+    /// First round of hash(), shared by every roll of a session
+    static uint64_t sessionKey(uint64_t globalSeed, uint64_t sessionId) noexcept {
+        return splitmix64(globalSeed ^ sessionId);
+    }
+
+    /// Remaining rounds of hash() from a sessionKey()
+    static uint64_t hashFrom(uint64_t key, uint64_t packetSeq, uint8_t direction) noexcept {
+        return splitmix64(splitmix64(key ^ packetSeq) ^ direction);
+    }
+
+    /// The 24 bits uniform() scales to [0, 1): uniform() < rate exactly when
+    /// bits24() < DecisionPlan::threshold(rate)
+    static uint32_t bits24(uint64_t h) noexcept {
+        return static_cast<uint32_t>(h >> 40);
     }
 
     /// Generate a float in [0.0, 1.0) from components
@@ -2,11 +2,13 @@
 
 #include <asio.hpp>
 #include <atomic>
+#include <optional>
 #include <thread>
 
 namespace shakyline {
 
 /// Wrapper around asio::io_context for the event loop
+/// Each loop is driven by exactly one thread (one shard per core)
 class EventLoop {
 public:
     EventLoop();
@@ -24,8 +26,8 @@ public:
     /// Run the event loop (blocking)
     void run();
 
-    /// Run in a background thread
-    void runInBackground();
+    /// Run in a background thread, optionally pinned to a CPU (-1 = unpinned)
+    void runInBackground(int cpu = -1);
 
     /// Stop the event loop
     void stop();
@@ -33,9 +35,19 @@ public:
     /// Wait for background thread to finish
     void join();
 
+    /// Run whatever handlers are ready on the calling thread until none are
+    /// left. Only for teardown, after the loop thread has been joined.
+    void drain();
+
     /// Check if running
     bool isRunning() const noexcept { return running_.load(); }
 
+    /// Reactor compiled into this binary ("io_uring" or "epoll"/platform default)
+    static const char* backendName() noexcept;
+
+    /// Probe whether the running kernel accepts io_uring_setup
+    static bool ioUringSupported() noexcept;
+
     /// Post work to the event loop
     template<typename Handler>
     void post(Handler&& handler) {
@@ -49,6 +61,8 @@ public:
     }
 
 private:
+    static void pinCurrentThread(int cpu);
+
     asio::io_context io_;
     std::optional<asio::executor_work_guard<asio::io_context::executor_type>> workGuard_;
     std::atomic<bool> running_{false};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace shakyline {
+
+/// Per-thread free list allocator for fixed-size objects
+/// Used with std::allocate_shared so an object and its control block are one
+/// block that is recycled on the same loop instead of going back to malloc.
+template<typename T>
+class FreeListAllocator {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t MAX_CACHED = 4096;
+
+    FreeListAllocator() noexcept = default;
+    template<typename U>
+    FreeListAllocator(const FreeListAllocator<U>&) noexcept {}
+
+    T* allocate(std::size_t n) {
+        if (n == 1) {
+            auto& list = freeList();
+            if (!list.empty()) {
+                void* block = list.back();
+                list.pop_back();
+                return static_cast<T*>(block);
+            }
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n) noexcept {
+        auto& list = freeList();
+        if (n == 1 && list.size() < MAX_CACHED) {
+            try {
+                list.push_back(p);
+                return;
+            } catch (...) {
+                // Fall through and free it
+            }
+        }
+        ::operator delete(p);
+    }
+
+    template<typename U>
+    bool operator==(const FreeListAllocator<U>&) const noexcept { return true; }
+    template<typename U>
+    bool operator!=(const FreeListAllocator<U>&) const noexcept { return false; }
+
+private:
+    /// Blocks owned by this thread's list are freed when the thread exits
+    struct List : std::vector<void*> {
+        ~List() {
+            for (void* block : *this) ::operator delete(block);
+        }
+    };
+
+    static List& freeList() {
+        thread_local List list;
+        return list;
+    }
+};
+
+/// Fixed in-object storage for one outstanding asio handler at a time
+/// Repeated read/write completions reuse it instead of allocating
+class HandlerMemory {
+public:
+    static constexpr std::size_t SIZE = 512;
+
+    HandlerMemory() noexcept = default;
+
+    // Non-copyable
+    HandlerMemory(const HandlerMemory&) = delete;
+    HandlerMemory& operator=(const HandlerMemory&) = delete;
+
+    void* allocate(std::size_t size) {
+        if (!inUse_ && size <= SIZE) {
+            inUse_ = true;
+            return storage_;
+        }
+        return ::operator new(size);
+    }
+
+    void deallocate(void* pointer) noexcept {
+        if (pointer == storage_) {
+            inUse_ = false;
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[SIZE];
+    bool inUse_ = false;
+};
+
+/// Allocator handed to asio via a handler's associated allocator
+template<typename T>
+class HandlerAllocator {
+public:
+    using value_type = T;
+
+    explicit HandlerAllocator(HandlerMemory& memory) noexcept : memory_(&memory) {}
+    template<typename U>
+    HandlerAllocator(const HandlerAllocator<U>& other) noexcept : memory_(other.memory_) {}
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(memory_->allocate(sizeof(T) * n));
+    }
+
+    void deallocate(T* p, std::size_t) noexcept {
+        memory_->deallocate(p);
+    }
+
+    template<typename U>
+    bool operator==(const HandlerAllocator<U>& other) const noexcept {
+        return memory_ == other.memory_;
+    }
+    template<typename U>
+    bool operator!=(const HandlerAllocator<U>& other) const noexcept {
+        return memory_ != other.memory_;
+    }
+
+private:
+    template<typename> friend class HandlerAllocator;
+    HandlerMemory* memory_;
+};
+
+/// Wraps a completion handler so asio allocates its operation from HandlerMemory
+template<typename Handler>
+class AllocHandler {
+public:
+    using allocator_type = HandlerAllocator<Handler>;
+
+    AllocHandler(HandlerMemory& memory, Handler handler)
+        : memory_(memory), handler_(std::move(handler)) {}
+
+    allocator_type get_allocator() const noexcept {
+        return allocator_type(memory_);
+    }
+
+    template<typename... Args>
+    void operator()(Args&&... args) {
+        handler_(std::forward<Args>(args)...);
+    }
+
+private:
+    HandlerMemory& memory_;
+    Handler handler_;
+};
+
+template<typename Handler>
+AllocHandler<std::decay_t<Handler>> makeAllocHandler(HandlerMemory& memory, Handler&& handler) {
+    return AllocHandler<std::decay_t<Handler>>(memory, std::forward<Handler>(handler));
+}
+
+} // namespace shakyline
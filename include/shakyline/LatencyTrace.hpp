@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace shakyline {
+
+/// Empirical delay distribution compiled from recorded latency samples
+/// The samples are reduced to a quantile table of SIZE delays (µs, bin
+/// midpoints of the sorted samples), so the top bits of a uniform 24-bit
+/// roll draw from it in O(1). On Linux the table lives in a read-only
+/// mapping, either of a trace file (which later runs open without
+/// re-parsing) or anonymous; elsewhere it is read into the heap. Either
+/// way it is shared by every plan whose profile names the trace.
+class LatencyTrace {
+public:
+    static constexpr unsigned BITS = 16;
+    static constexpr std::size_t SIZE = std::size_t(1) << BITS;
+    static constexpr const char* FILE_SUFFIX = ".trace";
+
+    /// Compile whitespace-separated samples in µs (decimals are rounded)
+    /// Written to `path` and mapped from there, or mapped anonymously if
+    /// `path` is empty. Throws std::invalid_argument on malformed samples,
+    /// std::runtime_error on I/O errors.
+    static std::shared_ptr<const LatencyTrace> build(std::string_view samples,
+                                                     const std::string& path = {});
+
+    /// Load a trace file written by build(); throws std::runtime_error
+    static std::shared_ptr<const LatencyTrace> open(const std::string& path);
+
+    ~LatencyTrace();
+
+    // Non-copyable
+    LatencyTrace(const LatencyTrace&) = delete;
+    LatencyTrace& operator=(const LatencyTrace&) = delete;
+
+    uint32_t sample(uint32_t bits24) const noexcept { return table_[bits24 >> (24 - BITS)]; }
+
+    /// Samples the table was built from
+    uint64_t sampleCount() const noexcept;
+
+private:
+    /// Takes over an mmap'd image, unmapped on destruction
+    LatencyTrace(void* mapping, std::size_t size) noexcept;
+
+    /// Heap-backed image, where mappings are unavailable
+    explicit LatencyTrace(std::unique_ptr<uint64_t[]> image) noexcept;
+
+    const void* image_;           // Header, then the table
+    std::size_t mappingSize_ = 0; // 0 when heap-backed
+    std::unique_ptr<uint64_t[]> heap_;
+    const uint32_t* table_;
+};
+
+} // namespace shakyline
@@ -44,12 +44,13 @@ public:
     void addBytesDownstream(uint64_t bytes) { bytesDownstream_.fetch_add(bytes); }
     void incrementPacketsDropped() { packetsDropped_.fetch_add(1); }
     void incrementPacketsDelayed() { packetsDelayed_.fetch_add(1); }
+    void incrementPacketsReordered() { packetsReordered_.fetch_add(1); }
     void incrementStallEvents() { stallEvents_.fetch_add(1); }
     void incrementHalfCloseEvents() { halfCloseEvents_.fetch_add(1); }
     void incrementConnectFailures() { connectFailures_.fetch_add(1); }
 
     // Histogram observations
-    void observeLatencyInjected(uint64_t ms);
+    void observeLatencyInjected(uint64_t us);  // Into both latency histograms
     void observeSessionLifetime(uint64_t seconds);
     void observeBufferOccupancy(uint64_t bytes);
 
@@ -63,12 +64,14 @@ private:
     std::atomic<uint64_t> bytesDownstream_{0};
     std::atomic<uint64_t> packetsDropped_{0};
     std::atomic<uint64_t> packetsDelayed_{0};
+    std::atomic<uint64_t> packetsReordered_{0};
     std::atomic<uint64_t> stallEvents_{0};
     std::atomic<uint64_t> halfCloseEvents_{0};
     std::atomic<uint64_t> connectFailures_{0};
 
     // Histograms
     std::unique_ptr<Histogram> latencyHist_;
+    std::unique_ptr<Histogram> latencyUsHist_;  // Resolves sub-ms (precise) delays
     std::unique_ptr<Histogram> lifetimeHist_;
     std::unique_ptr<Histogram> bufferHist_;
 };
@@ -6,6 +6,7 @@
 #include <asio.hpp>
 #include <memory>
 #include <atomic>
+#include <vector>
 
 namespace shakyline {
 
@@ -30,6 +31,12 @@ public:
     /// Stop accepting (graceful)
     void stop();
 
+    /// Hand accepted sockets to the least-loaded of these shards
+    /// (balanced accept mode; empty = keep every session on this loop)
+    void setHandoffTargets(std::vector<SessionManager::Ptr> targets) {
+        handoffTargets_ = std::move(targets);
+    }
+
     /// Check if running
     bool isRunning() const noexcept { return running_.load(); }
 
@@ -39,10 +46,12 @@ public:
 private:
     void doAccept();
     void onAccept(const asio::error_code& ec, asio::ip::tcp::socket socket);
+    void handOff(asio::ip::tcp::socket socket, const std::string& remoteAddr);
 
     asio::io_context& io_;
     asio::ip::tcp::acceptor acceptor_;
     SessionManager::Ptr sessionManager_;
+    std::vector<SessionManager::Ptr> handoffTargets_;
     ServerConfig config_;
     std::atomic<bool> running_{false};
 };
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "shakyline/Buffer.hpp"
+#include "shakyline/DelayQueue.hpp"
+
+#include <asio.hpp>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace shakyline {
+
+/// Due delayed packets waiting to be written straight from DelayQueue storage
+/// The packets follow the first aheadBytes() of the direction's Buffer, so a
+/// single gathering write sends both without copying payloads into the Buffer.
+/// A packet's payload goes back to the queue once a write has covered it.
+/// Owned per direction by a Session; loop thread only.
+class ReleaseList {
+public:
+    static constexpr std::size_t MAX_GATHER = 64;  // iovecs per write
+
+    /// Can due packets be queued here? Not once newer forwarded bytes sit in
+    /// the Buffer behind the list: later packets must follow those, by copy
+    bool canAccept(const Buffer& buf) const noexcept {
+        return empty() || buf.readable() == aheadBytes_;
+    }
+
+    /// Queue a packet popped from the direction's DelayQueue
+    void push(const DelayedPacket& pkt, const Buffer& buf);
+
+    bool empty() const noexcept { return head_ == packets_.size(); }
+
+    /// Unsent payload bytes
+    std::size_t bytes() const noexcept { return bytes_; }
+
+    /// Buffer bytes that go out before the packets
+    std::size_t aheadBytes() const noexcept { return empty() ? 0 : aheadBytes_; }
+
+    // --- Flow control (the packets count as if they sat in the Buffer) ---
+
+    bool shouldPauseReading(const Buffer& buf) const noexcept {
+        return buf.readable() + bytes_ >= Buffer::HIGH_WATERMARK;
+    }
+
+    bool shouldResumeReading(const Buffer& buf) const noexcept {
+        return buf.readable() + bytes_ <= Buffer::LOW_WATERMARK;
+    }
+
+    /// Next write, in stream order: Buffer bytes ahead of the packets (all of
+    /// them if there are no packets), then packet payloads, at most `limit` bytes
+    /// Valid until the next gather(); pins the Buffer like dataToSend()
+    std::span<const asio::const_buffer> gather(Buffer& buf, const DelayQueue& queue,
+                                               std::size_t limit);
+
+    /// Account a completed write: consume Buffer bytes, release sent packets
+    void consume(std::size_t written, Buffer& buf, DelayQueue& queue) noexcept;
+
+private:
+    std::vector<DelayedPacket> packets_;  // Reused; [head_, size) unsent, compacted in consume()
+    std::size_t head_ = 0;
+    std::size_t frontOffset_ = 0;  // Bytes of the head packet already written
+    std::size_t bytes_ = 0;
+    std::size_t aheadBytes_ = 0;
+    std::vector<asio::const_buffer> gather_;
+};
+
+} // namespace shakyline
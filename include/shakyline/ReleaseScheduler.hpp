@@ -0,0 +1,101 @@
+#pragma once
+
+#include <asio.hpp>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace shakyline {
+
+class Session;
+
+/// Per-loop release timer shared by every session's delay queues
+/// Keeps a min-heap of (release time, session) and one asio timer for the
+/// earliest entry; all sessions due at a wakeup are flushed as one batch.
+/// Sessions register only when their earliest deadline moves earlier, and
+/// discard entries that no longer match their current deadline.
+/// Entries name a session by slot and generation, not by pointer into the
+/// Session allocation: a closed session's leftover entries pin nothing, and
+/// are dropped in bulk once they make up half the heap.
+/// Precise entries (microsecond profiles) wake SPIN_WINDOW early and spin to
+/// the deadline, trading a little loop time for wakeup-latency-free release.
+/// While any are queued the loop thread's timer slack is cut to 1ns; it goes
+/// back to the default once they drain, so plain profiles cost no wakeups.
+/// Not thread-safe: use only from the owning loop's thread.
+class ReleaseScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// How early a precise entry wakes the loop (covers wakeup latency)
+    static constexpr std::chrono::microseconds SPIN_WINDOW{50};
+
+    explicit ReleaseScheduler(asio::io_context& io);
+    ~ReleaseScheduler();
+
+    // Non-copyable, non-movable
+    ReleaseScheduler(const ReleaseScheduler&) = delete;
+    ReleaseScheduler& operator=(const ReleaseScheduler&) = delete;
+
+    /// A session's registration; its entries go stale when it detaches
+    struct Handle {
+        uint32_t slot;
+        uint32_t generation;
+    };
+
+    /// Register a session for the lifetime of its Handle
+    Handle attach(Session& session);
+
+    /// Unregister (from ~Session); the session's queued entries are dropped
+    void detach(Handle handle) noexcept;
+
+    /// Call onReleaseDue(when) on the handle's session once `when` has passed
+    void request(Clock::time_point when, Handle handle, bool precise = false);
+
+    /// Entries waiting (including stale ones not yet dropped)
+    std::size_t pending() const noexcept { return heap_.size(); }
+
+private:
+    /// Below this many stale entries, leave them for onTimer to skip
+    static constexpr std::size_t COMPACT_MIN = 64;
+
+    struct Slot {
+        Session* session = nullptr;  // nullptr = free
+        uint32_t generation = 0;
+        uint32_t pending = 0;        // Entries in heap_ for this generation
+    };
+
+    struct Entry {
+        Clock::time_point when;
+        uint32_t slot;
+        uint32_t generation;
+        bool precise;
+
+        Clock::time_point wakeAt() const noexcept {
+            return precise ? when - SPIN_WINDOW : when;
+        }
+
+        bool operator>(const Entry& other) const noexcept {
+            return when > other.when;
+        }
+    };
+
+    void arm();
+    void setTightSlack(bool tight) noexcept;
+    void spinUntilDue();
+    void onTimer(const asio::error_code& ec);
+    void dropStale();
+
+    asio::steady_timer timer_;
+    std::vector<Slot> slots_;
+    std::vector<uint32_t> freeSlots_;
+    std::size_t stale_ = 0;             // Entries in heap_ of detached sessions
+    std::size_t precise_ = 0;           // Precise entries in heap_
+    bool tightSlack_ = false;
+    std::vector<Entry> heap_;
+    std::vector<Entry> batch_;          // Reused across wakeups
+    Clock::time_point armedAt_ = Clock::time_point::max();
+    bool firing_ = false;
+};
+
+} // namespace shakyline
@@ -1,39 +1,62 @@
 #pragma once
 
 #include <asio.hpp>
+#include <array>
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <functional>
+#include <deque>
 #include <memory>
-#include <mutex>
-#include <unordered_map>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 namespace shakyline {
 
-/// Timer scheduler using asio::steady_timer
+/// Hierarchical timing wheel driven by a single asio::steady_timer per loop
+/// - 1ms ticks, 4 levels x 64 slots (~4.6h range; longer delays re-cascade)
+/// - O(1) schedule/cancel; timer nodes are pooled and linked intrusively
+/// - Callbacks are stored inline in the node (no per-timer heap allocation)
+/// Not thread-safe: use only from the owning loop's thread.
 /// Supports weak_ptr guards for safe cancellation
 class Scheduler {
 public:
     using TimerId = uint64_t;
-    using Callback = std::function<void()>;
     using Clock = std::chrono::steady_clock;
 
+    /// Inline callback capacity (a weak_ptr guard plus a small lambda fits)
+    static constexpr std::size_t CALLBACK_STORAGE = 48;
+
     explicit Scheduler(asio::io_context& io);
-    ~Scheduler() = default;
+    ~Scheduler();
 
     // Non-copyable, non-movable
     Scheduler(const Scheduler&) = delete;
     Scheduler& operator=(const Scheduler&) = delete;
 
     /// Schedule a callback after delay
-    /// Returns timer ID for cancellation
-    TimerId schedule(std::chrono::milliseconds delay, Callback cb);
+    /// Returns timer ID for cancellation (never 0)
+    template<typename F>
+    TimerId schedule(std::chrono::milliseconds delay, F&& cb) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= CALLBACK_STORAGE,
+                      "Timer callback too large for inline storage");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                      "Timer callback over-aligned");
+
+        uint32_t index = allocateNode();
+        TimerNode& node = nodes_[index];
+        new (node.storage) Fn(std::forward<F>(cb));
+        node.invoke = [](void* p) { (*static_cast<Fn*>(p))(); };
+        node.destroy = [](void* p) { static_cast<Fn*>(p)->~Fn(); };
+        return arm(index, delay);
+    }
 
     /// Schedule with a guard - callback only fires if guard is still valid
-    template<typename T>
+    template<typename T, typename F>
     TimerId scheduleGuarded(std::chrono::milliseconds delay,
                             std::weak_ptr<T> guard,
-                            std::function<void(std::shared_ptr<T>)> cb) {
+                            F cb) {
         return schedule(delay, [guard = std::move(guard), cb = std::move(cb)]() {
             if (auto locked = guard.lock()) {
                 cb(std::move(locked));
@@ -49,13 +72,56 @@ public:
     void cancelAll();
 
     /// Number of active timers
-    std::size_t activeCount() const;
+    std::size_t activeCount() const noexcept { return activeCount_; }
 
 private:
-    asio::io_context& io_;
-    std::mutex mutex_;
-    std::unordered_map<TimerId, std::unique_ptr<asio::steady_timer>> timers_;
-    std::atomic<TimerId> nextId_{1};
+    static constexpr unsigned SLOT_BITS = 6;
+    static constexpr std::size_t SLOTS = std::size_t(1) << SLOT_BITS;
+    static constexpr uint64_t SLOT_MASK = SLOTS - 1;
+    static constexpr std::size_t LEVELS = 4;
+    static constexpr uint64_t MAX_SPAN = (uint64_t(1) << (SLOT_BITS * LEVELS)) - 1;
+    static constexpr uint32_t NIL = UINT32_MAX;
+    static constexpr uint16_t WORK_BUCKET = LEVELS * SLOTS;
+    static constexpr uint16_t NO_BUCKET = WORK_BUCKET + 1;
+    static constexpr uint16_t RUNNING = WORK_BUCKET + 2;
+
+    struct TimerNode {
+        alignas(std::max_align_t) unsigned char storage[CALLBACK_STORAGE];
+        void (*invoke)(void*) = nullptr;
+        void (*destroy)(void*) = nullptr;
+        uint64_t expiry = 0;        // Absolute tick
+        uint32_t next = NIL;        // Bucket list / free list link
+        uint32_t prev = NIL;
+        uint32_t generation = 1;    // Bumped on free so stale IDs miss
+        uint16_t bucket = NO_BUCKET;
+    };
+
+    uint32_t allocateNode();
+    void freeNode(uint32_t index) noexcept;
+    TimerId arm(uint32_t index, std::chrono::milliseconds delay);
+
+    void link(uint32_t index);
+    void pushBucket(uint16_t bucket, uint32_t index) noexcept;
+    void unlink(uint32_t index) noexcept;
+    uint32_t& head(uint16_t bucket) noexcept;
+
+    uint64_t nowTick() const noexcept;
+    void advance(uint64_t targetTick);
+    void cascade(std::size_t level);
+    void rearm();
+    void onTick(const asio::error_code& ec);
+
+    asio::steady_timer timer_;
+    Clock::time_point epoch_;
+    uint64_t currentTick_ = 0;          // Next tick to process
+    uint64_t armedTick_ = UINT64_MAX;   // Tick the asio timer fires at
+
+    std::deque<TimerNode> nodes_;       // Stable addresses as it grows
+    uint32_t freeHead_ = NIL;
+    std::array<uint32_t, LEVELS * SLOTS> buckets_;
+    uint32_t workHead_ = NIL;           // Timers being fired this tick
+    bool advancing_ = false;            // onTick re-arms once after callbacks
+    std::size_t activeCount_ = 0;
 };
 
 } // namespace shakyline
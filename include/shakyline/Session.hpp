@@ -4,8 +4,13 @@
 #include "shakyline/Buffer.hpp"
 #include "shakyline/Config.hpp"
 #include "shakyline/DelayQueue.hpp"
+#include "shakyline/HandlerAllocator.hpp"
+#include "shakyline/ReleaseList.hpp"
+#include "shakyline/ReleaseScheduler.hpp"
 #include "shakyline/Scheduler.hpp"
 #include "shakyline/Socket.hpp"
+#include "shakyline/SplicePipe.hpp"
+#include "shakyline/TokenBucket.hpp"
 
 #include <asio.hpp>
 #include <chrono>
@@ -36,17 +41,35 @@ enum class UpstreamState {
     Failed
 };
 
-/// Session: bidirectional proxy connection with strand serialization
+/// Session: bidirectional proxy connection pinned to one event loop shard
+/// All handlers run on that loop's single thread, so no strand is needed
 class Session : public std::enable_shared_from_this<Session> {
+    struct PrivateTag { explicit PrivateTag() = default; };
+
 public:
     using Ptr = std::shared_ptr<Session>;
 
     /// Factory method - creates session but does NOT start it
+    /// Session and control block come from the loop's recycled free list
     static Ptr create(
         asio::io_context& io,
         Socket clientSocket,
         std::weak_ptr<SessionManager> manager,
         Scheduler& scheduler,
+        ReleaseScheduler& releaser,
+        const AnomalyEngine& engine,
+        ConfigManager& config,
+        uint64_t sessionId
+    );
+
+    /// Use create(); public only so allocate_shared can construct it
+    Session(
+        PrivateTag,
+        asio::io_context& io,
+        Socket clientSocket,
+        std::weak_ptr<SessionManager> manager,
+        Scheduler& scheduler,
+        ReleaseScheduler& releaser,
         const AnomalyEngine& engine,
         ConfigManager& config,
         uint64_t sessionId
@@ -58,7 +81,7 @@ public:
     Session(const Session&) = delete;
     Session& operator=(const Session&) = delete;
 
-    /// Start the session (must be called via strand post after construction)
+    /// Start the session (must be posted to its loop after construction)
     void start(const asio::ip::tcp::endpoint& upstream);
 
     /// Initiate graceful shutdown
@@ -70,48 +93,72 @@ public:
     /// Get session ID
     uint64_t id() const noexcept { return sessionId_; }
 
-    /// Get strand for external posts
-    asio::strand<asio::io_context::executor_type>& strand() { return strand_; }
+    /// Get the owning loop's executor for external posts
+    asio::io_context::executor_type executor() const noexcept { return executor_; }
 
     /// Check if session is closed
     bool isClosed() const noexcept { return channels_.isFullyClosed(); }
 
+    /// Flush due delayed packets (ReleaseScheduler callback, loop thread)
+    /// `when` is the deadline the entry was registered for; stale ones are ignored
+    void onReleaseDue(std::chrono::steady_clock::time_point when);
+
+    /// Bytes buffered or delayed in both directions (loop thread only)
+    std::size_t queuedBytes() const noexcept {
+        return clientToServerBuf_.readable() + serverToClientBuf_.readable() +
+               clientToServerReleased_.bytes() + serverToClientReleased_.bytes() +
+               clientToServerDelay_.totalBytes() + serverToClientDelay_.totalBytes();
+    }
+
     /// Get idle time
     std::chrono::steady_clock::duration idleTime() const {
         return std::chrono::steady_clock::now() - lastActivity_;
     }
 
 private:
-    Session(
-        asio::io_context& io,
-        Socket clientSocket,
-        std::weak_ptr<SessionManager> manager,
-        Scheduler& scheduler,
-        const AnomalyEngine& engine,
-        ConfigManager& config,
-        uint64_t sessionId
-    );
-
     // --- Event handlers ---
     void onConnectComplete(const asio::error_code& ec);
-    void onClientRead(const asio::error_code& ec, std::size_t bytesRead);
-    void onServerRead(const asio::error_code& ec, std::size_t bytesRead);
+    void onClientRead(const asio::error_code& ec);
+    void onServerRead(const asio::error_code& ec);
     void onClientWrite(const asio::error_code& ec, std::size_t bytesWritten);
     void onServerWrite(const asio::error_code& ec, std::size_t bytesWritten);
-    void onDelayExpired();
     void onConnectTimeout();
     void onIdleTimeout();
-    void onStallTimeout();
+    void onStallTimeout(Direction direction);
+    void onClientSpliceReadable(const asio::error_code& ec);
+    void onServerSpliceReadable(const asio::error_code& ec);
+    void onClientSpliceWritable(const asio::error_code& ec);
+    void onServerSpliceWritable(const asio::error_code& ec);
 
     // --- I/O helpers ---
     void startClientRead();
     void startServerRead();
     void startClientWrite();
     void startServerWrite();
+    // Data lives in the outbound buffer's uncommitted tail; forwarding commits
+    // it, drops/delays leave it uncommitted (rolled back by the next read)
     void processClientData(std::span<uint8_t> data);
     void processServerData(std::span<uint8_t> data);
     void flushDelayQueues();
     void scheduleDelayFlush();
+    std::size_t drainDelayQueue(DelayQueue& queue, Buffer& buf, ReleaseList& released,
+                                std::chrono::steady_clock::time_point now, bool& blocked);
+
+    // --- Reorder window and stalls ---
+    bool holdForReorder(Direction direction, std::span<const uint8_t> data,
+                        uint64_t packetSeq, uint32_t delayUs);
+    void segmentPassed(Direction direction);
+    void releaseReordered(Direction direction);
+    void stallRead(Direction direction, std::span<const uint8_t> data,
+                   uint64_t packetSeq, uint32_t stallMs);
+
+    // --- Zero-copy pass-through (fault-free directions) ---
+    void refreshProfile();
+    bool canSplice(Direction direction);
+    void startClientSplice();
+    void startServerSplice();
+    void pumpClientSplice();
+    void pumpServerSplice();
 
     // --- State management ---
     void closeClientRead();
@@ -119,18 +166,21 @@ private:
     void closeServerRead();
     void closeServerWrite();
     void checkFullyClosed();
-    void resetIdleTimer();
+    void armIdleTimer(std::chrono::milliseconds delay);
+    void maybeResumeClientRead();
+    void maybeResumeServerRead();
     void recordActivity();
 
     // --- Adaptive budget ---
     std::size_t calculateBudget() const;
 
     // Core state
-    asio::strand<asio::io_context::executor_type> strand_;
+    asio::io_context::executor_type executor_;
     Socket clientSocket_;
     Socket serverSocket_;
     std::weak_ptr<SessionManager> manager_;
     Scheduler& scheduler_;
+    ReleaseScheduler& releaser_;
     const AnomalyEngine& engine_;
     ConfigManager& config_;
     uint64_t sessionId_;
@@ -144,28 +194,63 @@ private:
     Buffer serverToClientBuf_;
     DelayQueue clientToServerDelay_;
     DelayQueue serverToClientDelay_;
-
-    // Read buffers for async_read
-    std::array<uint8_t, 32768> clientReadBuf_;
-    std::array<uint8_t, 32768> serverReadBuf_;
+    ReleaseList clientToServerReleased_;  // Due packets written from delay storage
+    ReleaseList serverToClientReleased_;
+    bool c2sFlushBlocked_ = false;  // Due delayed packet waiting for buffer room
+    bool s2cFlushBlocked_ = false;
+
+    // Reorder fault: one segment per direction held until reorderDistance
+    // later segments have passed (bytes stay in that direction's arena)
+    struct ReorderSlot {
+        std::optional<DelayedPacket> held;
+        uint32_t remaining = 0;
+        uint32_t delayUs = 0;
+        Scheduler::TimerId timerId = 0;  // MAX_REORDER_HOLD_MS fallback
+    };
+    ReorderSlot c2sReorder_;
+    ReorderSlot s2cReorder_;
+
+    // Decision state carried between packets (burst loss, delay correlation)
+    DecisionState clientToServerDecision_;
+    DecisionState serverToClientDecision_;
+
+    // Bandwidth pacing (throttle_kbps), applied where each direction is written
+    TokenBucket clientToServerBucket_;
+    TokenBucket serverToClientBucket_;
 
     // Packet sequence counters
     uint64_t clientPktSeq_ = 0;
     uint64_t serverPktSeq_ = 0;
 
-    // Profile snapshot
-    AnomalyProfile currentProfile_;
+    // Profile snapshot (compiled plan, shared with ConfigManager)
+    std::shared_ptr<const DecisionPlan> plan_ = DecisionPlan::empty();
     uint32_t profileVersion_ = 0;
+    uint64_t profileGeneration_ = UINT64_MAX;  // Forces the first fetch
+
+    // splice(2) pipes, opened the first time a direction runs fault-free
+    SplicePipe clientToServerPipe_;
+    SplicePipe serverToClientPipe_;
 
     // Timers
     Scheduler::TimerId connectTimerId_ = 0;
     Scheduler::TimerId idleTimerId_ = 0;
-    Scheduler::TimerId stallTimerId_ = 0;
-    Scheduler::TimerId delayTimerId_ = 0;
+    Scheduler::TimerId clientStallTimerId_ = 0;
+    Scheduler::TimerId serverStallTimerId_ = 0;
+    Scheduler::TimerId clientPaceTimerId_ = 0;
+    Scheduler::TimerId serverPaceTimerId_ = 0;
 
     // Activity tracking
     std::chrono::steady_clock::time_point startTime_;
     std::chrono::steady_clock::time_point lastActivity_;
+    std::chrono::steady_clock::time_point releaseDeadline_ =
+        std::chrono::steady_clock::time_point::max();  // Registered with releaser_
+    ReleaseScheduler::Handle releaseHandle_;
+
+    // Recycled handler storage: at most one outstanding op per slot
+    HandlerMemory clientReadMem_;
+    HandlerMemory serverReadMem_;
+    HandlerMemory clientWriteMem_;
+    HandlerMemory serverWriteMem_;
 
     // Write-in-progress flags
     bool clientWriteInProgress_ = false;
@@ -174,6 +259,8 @@ private:
     // Read paused flags (for backpressure)
     bool clientReadPaused_ = false;
     bool serverReadPaused_ = false;
+    bool clientStalled_ = false;  // Paused by a Stall fault; only its timer resumes
+    bool serverStalled_ = false;
 };
 
 } // namespace shakyline
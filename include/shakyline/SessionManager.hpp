@@ -3,6 +3,7 @@
 #include "shakyline/AnomalyEngine.hpp"
 #include "shakyline/Config.hpp"
 #include "shakyline/EventLoop.hpp"
+#include "shakyline/ReleaseScheduler.hpp"
 #include "shakyline/Scheduler.hpp"
 #include "shakyline/Session.hpp"
 
@@ -14,7 +15,8 @@
 
 namespace shakyline {
 
-/// Session ownership and admission control
+/// Session ownership and admission control for one event loop shard
+/// Session IDs are interleaved across shards so they stay globally unique
 class SessionManager : public std::enable_shared_from_this<SessionManager> {
 public:
     using Ptr = std::shared_ptr<SessionManager>;
@@ -22,8 +24,11 @@ public:
     static Ptr create(
         asio::io_context& io,
         Scheduler& scheduler,
+        ReleaseScheduler& releaser,
         const AnomalyEngine& engine,
-        ConfigManager& config
+        ConfigManager& config,
+        std::size_t shardIndex = 0,
+        std::size_t shardCount = 1
     );
 
     ~SessionManager();
@@ -60,6 +65,26 @@ public:
     /// Check if accepting new connections
     bool canAccept() const;
 
+    /// Session limit for this shard (global limit split across shards)
+    std::size_t maxSessions() const noexcept { return maxSessions_; }
+
+    /// The shard's io_context
+    asio::io_context& context() noexcept { return io_; }
+
+    // --- Load-aware accept handoff ---
+
+    /// Adopt a socket accepted on another shard (thread-safe)
+    /// The descriptor is re-registered with this shard's loop
+    void adoptSocket(asio::ip::tcp::socket::protocol_type protocol,
+                     asio::ip::tcp::socket::native_handle_type fd);
+
+    /// Refresh load figures (call on this shard's loop thread)
+    void sampleLoad(std::chrono::microseconds loopLag);
+
+    /// Relative load for handoff decisions (thread-safe, lower is better)
+    /// One unit ~ one session, one full Buffer of queued bytes, or 1ms of loop lag
+    uint64_t loadScore() const noexcept;
+
     /// Get the upstream endpoint
     void setUpstreamEndpoint(const asio::ip::tcp::endpoint& endpoint) {
         upstreamEndpoint_ = endpoint;
@@ -72,8 +97,11 @@ private:
     SessionManager(
         asio::io_context& io,
         Scheduler& scheduler,
+        ReleaseScheduler& releaser,
         const AnomalyEngine& engine,
-        ConfigManager& config
+        ConfigManager& config,
+        std::size_t shardIndex,
+        std::size_t shardCount
     );
 
     bool tryAdmit();
@@ -81,13 +109,22 @@ private:
 
     asio::io_context& io_;
     Scheduler& scheduler_;
+    ReleaseScheduler& releaser_;
     const AnomalyEngine& engine_;
     ConfigManager& config_;
     asio::ip::tcp::endpoint upstreamEndpoint_;
+    std::size_t shardIndex_;
+    std::size_t shardCount_;
+    std::size_t maxSessions_;
 
     mutable std::mutex mutex_;
     std::unordered_map<uint64_t, Session::Ptr> sessions_;
     std::atomic<uint64_t> nextSessionId_{1};
+
+    // Load snapshot read by the accepting shard
+    std::atomic<uint64_t> pendingHandoffs_{0};
+    std::atomic<uint64_t> queuedBytes_{0};
+    std::atomic<uint64_t> loopLagUs_{0};
 };
 
 } // namespace shakyline
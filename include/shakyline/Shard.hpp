@@ -0,0 +1,75 @@
+#pragma once
+
+#include "shakyline/AnomalyEngine.hpp"
+#include "shakyline/Config.hpp"
+#include "shakyline/EventLoop.hpp"
+#include "shakyline/ProxyServer.hpp"
+#include "shakyline/ReleaseScheduler.hpp"
+#include "shakyline/Scheduler.hpp"
+#include "shakyline/SessionManager.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace shakyline {
+
+/// One thread-per-core shard: event loop, timers, sessions and acceptor
+/// Sessions never leave the shard that accepted them
+class Shard {
+public:
+    Shard(
+        std::size_t index,
+        std::size_t count,
+        const AnomalyEngine& engine,
+        ConfigManager& config
+    );
+
+    ~Shard();
+
+    // Non-copyable, non-movable
+    Shard(const Shard&) = delete;
+    Shard& operator=(const Shard&) = delete;
+
+    /// Load sampling period for balanced accept handoff
+    static constexpr std::chrono::milliseconds LOAD_SAMPLE_INTERVAL{100};
+
+    /// Bind the acceptor (if accepting) and run the loop on its own thread
+    /// cpu < 0 leaves the thread unpinned
+    void start(int cpu = -1, bool accept = true);
+
+    /// Make this shard's acceptor hand sockets to the least-loaded target
+    void setHandoffTargets(std::vector<SessionManager::Ptr> targets) {
+        proxyServer_.setHandoffTargets(std::move(targets));
+    }
+
+    /// Stop accepting new connections
+    void stopAccepting();
+
+    /// Begin graceful shutdown of this shard's sessions
+    void shutdownSessions();
+
+    /// Force close this shard's sessions
+    void forceCloseSessions();
+
+    /// Stop the event loop and wait for its thread
+    void stop();
+
+    std::size_t index() const noexcept { return index_; }
+    EventLoop& loop() noexcept { return loop_; }
+    Scheduler& scheduler() noexcept { return scheduler_; }
+    const SessionManager::Ptr& sessions() const noexcept { return sessionManager_; }
+
+private:
+    void scheduleLoadSample();
+
+    std::size_t index_;
+    EventLoop loop_;
+    Scheduler scheduler_;
+    ReleaseScheduler releaser_;
+    SessionManager::Ptr sessionManager_;
+    ProxyServer proxyServer_;
+    asio::steady_timer loadTimer_;
+};
+
+} // namespace shakyline
@@ -86,6 +86,23 @@ public:
                           std::forward<Handler>(handler));
     }
 
+    /// Non-blocking read of whatever is available (ec = would_block if none)
+    std::size_t readSome(asio::mutable_buffer buffer, asio::error_code& ec) {
+        return socket_.read_some(buffer, ec);
+    }
+
+    /// Wait until the socket is readable (no data is consumed)
+    template<typename Handler>
+    void asyncWaitReadable(Handler&& handler) {
+        socket_.async_wait(tcp::socket::wait_read, std::forward<Handler>(handler));
+    }
+
+    /// Wait until the socket can accept more data
+    template<typename Handler>
+    void asyncWaitWritable(Handler&& handler) {
+        socket_.async_wait(tcp::socket::wait_write, std::forward<Handler>(handler));
+    }
+
     /// Get remote endpoint
     std::optional<tcp::endpoint> remoteEndpoint() const noexcept;
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace shakyline {
+
+/// Memory-mapped overflow storage for delay queues
+/// Each loop thread gets one unlinked temp file, carved into fixed-size
+/// segments that are mapped on demand. Pages are file-backed, so the kernel
+/// can write them out instead of growing anonymous RSS; released segments
+/// are hole-punched so the file does not keep the disk space either.
+/// Not thread-safe: used by its loop thread (or by whoever tears it down).
+class SpillStore {
+public:
+    static constexpr std::size_t SEGMENT_SIZE = 1024 * 1024;  // 1MB
+
+    struct Segment {
+        uint8_t* data = nullptr;
+        uint32_t index = 0;
+    };
+
+    SpillStore(std::string directory, std::size_t maxBytes);
+    ~SpillStore();
+
+    // Non-copyable
+    SpillStore(const SpillStore&) = delete;
+    SpillStore& operator=(const SpillStore&) = delete;
+
+    /// Enable spilling for loops started after this call (empty dir = off)
+    /// maxBytes is the budget per loop thread
+    static void configure(std::string directory, std::size_t maxBytes);
+
+    /// Store for the calling thread, or nullptr when spilling is disabled
+    static std::shared_ptr<SpillStore> local();
+
+    /// Platform check (needs posix_fallocate and shared file mappings)
+    static bool supported() noexcept;
+
+    /// Whether configure() turned spilling on (never where unsupported)
+    static bool enabled() noexcept;
+
+    /// Per-thread budget set by configure()
+    static std::size_t budget() noexcept;
+
+    /// Map a free segment; data is nullptr if over budget or on I/O error
+    Segment acquire();
+
+    /// Unmap a segment and give its disk space back
+    void release(const Segment& segment) noexcept;
+
+    /// Bytes currently mapped
+    std::size_t bytesInUse() const noexcept { return inUse_ * SEGMENT_SIZE; }
+
+    /// Budget left for new segments
+    std::size_t bytesFree() const noexcept {
+        return failed_ ? 0 : (maxSegments_ - inUse_) * SEGMENT_SIZE;
+    }
+
+private:
+    bool open();
+
+    std::string directory_;
+    std::size_t maxSegments_;
+    int fd_ = -1;
+    bool failed_ = false;
+    uint32_t fileSegments_ = 0;          // Segments the file is sized for
+    std::size_t inUse_ = 0;
+    std::vector<uint32_t> freeSegments_;
+};
+
+} // namespace shakyline
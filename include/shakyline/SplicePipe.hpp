@@ -0,0 +1,50 @@
+#pragma once
+
+#include <asio.hpp>
+#include <cstddef>
+
+namespace shakyline {
+
+/// Kernel pipe used to move bytes socket → pipe → socket with splice(2)
+/// Payload never enters user space. Linux only; elsewhere supported() is false.
+class SplicePipe {
+public:
+    SplicePipe() = default;
+    ~SplicePipe();
+
+    // Non-copyable, non-movable (owns two descriptors)
+    SplicePipe(const SplicePipe&) = delete;
+    SplicePipe& operator=(const SplicePipe&) = delete;
+
+    /// Whether this platform can splice at all
+    static bool supported() noexcept;
+
+    /// Create the pipe lazily; returns false if it could not be opened
+    bool open() noexcept;
+
+    /// Is the pipe open?
+    bool isOpen() const noexcept { return readFd_ >= 0; }
+
+    /// Bytes sitting in the pipe waiting to be drained
+    std::size_t pending() const noexcept { return pending_; }
+
+    /// Splice as much as fits from a socket into the pipe
+    /// Returns bytes moved; 0 with no error means EOF
+    /// ec = would_block when the socket has nothing to read
+    std::size_t fill(int socketFd, asio::error_code& ec) noexcept;
+
+    /// Splice pending bytes from the pipe into a socket
+    /// ec = would_block when the socket cannot take more yet
+    std::size_t drain(int socketFd, asio::error_code& ec) noexcept;
+
+    /// Close both ends (drops any pending bytes)
+    void close() noexcept;
+
+private:
+    int readFd_ = -1;
+    int writeFd_ = -1;
+    std::size_t capacity_ = 0;
+    std::size_t pending_ = 0;
+};
+
+} // namespace shakyline
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace shakyline {
+
+/// Token bucket for paced writes
+/// Refills continuously at rate bytes/s up to a burst of BURST_WINDOW worth
+/// of tokens (at least MIN_BURST), so a 1ms-granular wakeup never starves it.
+/// A rate of 0 means unlimited.
+class TokenBucket {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t MIN_BURST = 1500;           // ~one segment
+    static constexpr std::chrono::milliseconds BURST_WINDOW{5};
+
+    /// Change the rate (no-op if unchanged); keeps tokens up to the new burst
+    void setRate(uint64_t bytesPerSec) {
+        if (bytesPerSec == rate_) return;
+        refill(Clock::now());
+        rate_ = bytesPerSec;
+        burst_ = std::max<double>(MIN_BURST,
+            static_cast<double>(rate_) * BURST_WINDOW.count() / 1000.0);
+        tokens_ = std::min(tokens_, burst_);
+    }
+
+    bool limited() const noexcept { return rate_ != 0; }
+
+    /// Grant up to `want` bytes now; 0 until a worthwhile chunk
+    /// (min(want, burst)) can be sent, so slow links still write whole segments
+    std::size_t take(std::size_t want, Clock::time_point now) {
+        refill(now);
+        double threshold = std::min(static_cast<double>(want), burst_);
+        if (tokens_ < threshold) return 0;
+
+        std::size_t grant = std::min(want, static_cast<std::size_t>(tokens_));
+        tokens_ -= static_cast<double>(grant);
+        return grant;
+    }
+
+    /// Time until take(want) would grant something
+    std::chrono::nanoseconds waitFor(std::size_t want) const {
+        double threshold = std::min(static_cast<double>(want), burst_);
+        double deficit = threshold - tokens_;
+        if (deficit <= 0.0 || rate_ == 0) return std::chrono::nanoseconds(0);
+        return std::chrono::nanoseconds(
+            static_cast<int64_t>(deficit * 1e9 / static_cast<double>(rate_)) + 1);
+    }
+
+private:
+    void refill(Clock::time_point now) {
+        if (now > last_) {
+            double elapsed = std::chrono::duration<double>(now - last_).count();
+            tokens_ = std::min(burst_, tokens_ + elapsed * static_cast<double>(rate_));
+        }
+        last_ = now;
+    }
+
+    uint64_t rate_ = 0;
+    double burst_ = MIN_BURST;
+    double tokens_ = 0.0;
+    Clock::time_point last_{};
+};
+
+} // namespace shakyline
@@ -1,101 +1,329 @@
 #include "shakyline/AnomalyEngine.hpp"
 
+#include <algorithm>
+#include <cmath>
+
+#if SHAKYLINE_HAVE_AVX2_DISPATCH
+#include <immintrin.h>
+#endif
+
 namespace shakyline {
 
-AnomalyDecision AnomalyEngine::decide(
-    std::span<const uint8_t> data,
-    Direction direction,
-    uint64_t sessionId,
-    uint64_t packetSeq,
-    const AnomalyProfile& profile
-) const {
+namespace {
+
+/// Direction byte for sub-streams beyond the seven packetSeq*7+k slots,
+/// so newer faults never reuse an older fault's roll
+constexpr uint8_t extStream(uint8_t dir, uint8_t stream) noexcept {
+    return static_cast<uint8_t>(dir | (stream << 1));
+}
+
+constexpr uint8_t STREAM_REORDER = 1;
+constexpr uint8_t STREAM_STALL = 2;
+constexpr uint8_t STREAM_BURST = 3;
+
+/// Every hash a decision may use; slots 0-6 are the packetSeq*7+k rolls
+enum Roll : unsigned {
+    ROLL_DROP,
+    ROLL_HALF_CLOSE,
+    ROLL_STALL,
+    ROLL_CORRUPT,
+    ROLL_CORRUPT_OFFSET,
+    ROLL_CORRUPT_MASK,
+    ROLL_JITTER,
+    ROLL_REORDER,
+    ROLL_STALL_LENGTH,
+    ROLL_BURST,
+    ROLL_COUNT
+};
+
+/// Rolls a plan direction consumes for (nearly) every packet, one bit per
+/// Roll; the rest only follow a rare hit and are hashed on demand
+uint32_t rollsNeeded(const DirectionPlan& p) noexcept {
+    uint32_t rolls = 0;
+    if (p.faults & DirectionPlan::DROP) rolls |= 1u << ROLL_DROP;
+    if (p.faults & DirectionPlan::HALF_CLOSE) rolls |= 1u << ROLL_HALF_CLOSE;
+    if (p.faults & DirectionPlan::STALL) rolls |= 1u << ROLL_STALL;
+    if (p.faults & DirectionPlan::CORRUPT) rolls |= 1u << ROLL_CORRUPT;
+    if (p.faults & DirectionPlan::REORDER) rolls |= 1u << ROLL_REORDER;
+    if (p.delayJitter > 0 || p.delayTrace) rolls |= 1u << ROLL_JITTER;
+    if (p.faults & DirectionPlan::BURST_LOSS) rolls |= 1u << ROLL_BURST;
+    return rolls;
+}
+
+/// Hash inputs of a roll: hash(global, session, seq, dir)
+inline uint64_t rollSeq(Roll roll, uint64_t packetSeq) noexcept {
+    return roll < ROLL_REORDER ? packetSeq * 7 + (roll + 1) : packetSeq;
+}
+
+inline uint8_t rollDir(Roll roll, uint8_t dir) noexcept {
+    switch (roll) {
+        case ROLL_REORDER: return extStream(dir, STREAM_REORDER);
+        case ROLL_STALL_LENGTH: return extStream(dir, STREAM_STALL);
+        case ROLL_BURST: return extStream(dir, STREAM_BURST);
+        default: return dir;
+    }
+}
+
+/// The decision itself; `hash(roll)` supplies each roll's 64-bit hash, lazily
+/// (decide) or from a precomputed table (batch), so both paths share it
+template<typename Hash>
+AnomalyDecision decideWith(const DirectionPlan& p, std::size_t length, uint32_t maxStallMs,
+                           DecisionState* state, Hash&& hash) {
     AnomalyDecision decision;
-    const auto& dirProfile = getDirectionalProfile(direction, profile);
-    uint8_t dir = static_cast<uint8_t>(direction);
+    auto roll = [&](Roll r) { return DeterministicRng::bits24(hash(r)); };
 
-    // Use different sub-seeds for each decision type
-    // This ensures decisions are independent but deterministic
-    
-    // Check drop first (highest priority fault)
-    if (dirProfile.dropRate > 0.0f) {
-        float dropRoll = DeterministicRng::uniform(globalSeed_, sessionId, 
-                                                    packetSeq * 7 + 1, dir);
-        if (dropRoll < dirProfile.dropRate) {
+    // Gilbert-Elliott loss: the current state picks the loss rate, then the
+    // chain steps. One hash serves both (top and next-lower 24 bits), and
+    // the state advances on every packet, whatever else happens to it.
+    if ((p.faults & DirectionPlan::BURST_LOSS) && state) {
+        uint64_t h = hash(ROLL_BURST);
+        bool bad = state->burstBad;
+        bool lost = DeterministicRng::bits24(h) < p.burstLossThreshold[bad];
+        uint32_t step = static_cast<uint32_t>(h >> 16) & 0xffffffu;
+        state->burstBad = step < (bad ? (1u << 24) - p.burstExitThreshold
+                                        : p.burstEnterThreshold);
+        if (lost) {
             decision.action = AnomalyDecision::Action::Drop;
             return decision;
         }
     }
 
+    // Check drop first (highest priority fault)
+    if ((p.faults & DirectionPlan::DROP) && roll(ROLL_DROP) < p.dropThreshold) {
+        decision.action = AnomalyDecision::Action::Drop;
+        return decision;
+    }
+
     // Check half-close
-    if (dirProfile.halfCloseRate > 0.0f) {
-        float hcRoll = DeterministicRng::uniform(globalSeed_, sessionId,
-                                                  packetSeq * 7 + 2, dir);
-        if (hcRoll < dirProfile.halfCloseRate) {
-            decision.action = AnomalyDecision::Action::HalfClose;
-            return decision;
-        }
+    if ((p.faults & DirectionPlan::HALF_CLOSE) && roll(ROLL_HALF_CLOSE) < p.halfCloseThreshold) {
+        decision.action = AnomalyDecision::Action::HalfClose;
+        return decision;
     }
 
     // Check stall
-    if (dirProfile.stallProbability > 0.0f) {
-        float stallRoll = DeterministicRng::uniform(globalSeed_, sessionId,
-                                                     packetSeq * 7 + 3, dir);
-        if (stallRoll < dirProfile.stallProbability) {
-            decision.action = AnomalyDecision::Action::Stall;
-            return decision;
-        }
+    if ((p.faults & DirectionPlan::STALL) && roll(ROLL_STALL) < p.stallThreshold) {
+        decision.action = AnomalyDecision::Action::Stall;
+        uint32_t longest = p.stallMs ? std::min(p.stallMs, maxStallMs) : maxStallMs;
+        decision.stallMs = 1 + static_cast<uint32_t>(hash(ROLL_STALL_LENGTH) % longest);
+        return decision;
     }
 
     // Check corruption
-    if (dirProfile.corruptRate > 0.0f && !data.empty()) {
-        float corruptRoll = DeterministicRng::uniform(globalSeed_, sessionId,
-                                                       packetSeq * 7 + 4, dir);
-        if (corruptRoll < dirProfile.corruptRate) {
-            decision.action = AnomalyDecision::Action::Corrupt;
-            decision.corruptOffset = DeterministicRng::uniformInt(
-                globalSeed_, sessionId, packetSeq * 7 + 5, dir, 
-                static_cast<uint32_t>(data.size())
-            );
-            decision.corruptMask = static_cast<uint8_t>(
-                DeterministicRng::uniformInt(globalSeed_, sessionId, 
-                                             packetSeq * 7 + 6, dir, 256)
-            );
-            // Continue to also apply delay if configured
-        }
+    if ((p.faults & DirectionPlan::CORRUPT) && length > 0 &&
+        roll(ROLL_CORRUPT) < p.corruptThreshold) {
+        decision.action = AnomalyDecision::Action::Corrupt;
+        decision.corruptOffset = hash(ROLL_CORRUPT_OFFSET) % length;
+        decision.corruptMask = static_cast<uint8_t>(hash(ROLL_CORRUPT_MASK) % 256);
+        // Continue to also apply delay if configured
+    }
+
+    // Check reorder (a corrupted segment is not also held back)
+    if ((p.faults & DirectionPlan::REORDER) &&
+        decision.action == AnomalyDecision::Action::Forward &&
+        roll(ROLL_REORDER) < p.reorderThreshold) {
+        decision.action = AnomalyDecision::Action::Reorder;
     }
 
-    // Check delay/jitter
-    if (dirProfile.latencyMs > 0 || dirProfile.jitterMs > 0) {
-        uint32_t baseLatency = dirProfile.latencyMs;
-        if (dirProfile.jitterMs > 0) {
-            int32_t jitter = static_cast<int32_t>(
-                DeterministicRng::uniformInt(globalSeed_, sessionId,
-                                             packetSeq * 7 + 7, dir, 
-                                             dirProfile.jitterMs * 2 + 1)
-            ) - static_cast<int32_t>(dirProfile.jitterMs);
-            baseLatency = static_cast<uint32_t>(std::max(0, 
-                static_cast<int32_t>(baseLatency) + jitter));
+    // Check delay/jitter (in the plan's unit: ms, or µs for precise profiles)
+    if (p.faults & DirectionPlan::DELAY) {
+        int64_t delay = p.delayBase;
+        if (p.delayTrace) {
+            delay += p.delayTrace->sample(roll(ROLL_JITTER));
+            delay = std::min<int64_t>(delay, p.delayMax);
+        } else if (p.delayJitter > 0 && p.delayTable) {
+            float deviation = p.delayTable->sample(roll(ROLL_JITTER));
+            if (state && p.delayKeep > 0.0f) {
+                // Clamped so a run of tail draws cannot compound without bound
+                deviation = std::clamp(p.delayKeep * state->delayDeviation +
+                                           p.delayFresh * deviation,
+                                       p.delayTable->min(), p.delayTable->max());
+                state->delayDeviation = deviation;
+            }
+            delay += std::llround(static_cast<double>(deviation) * p.delayJitter);
+            delay = std::min<int64_t>(delay, p.delayMax);
+        } else if (p.delayJitter > 0) {
+            delay += static_cast<int64_t>(p.jitterMod(hash(ROLL_JITTER))) -
+                     static_cast<int64_t>(p.delayJitter);
         }
-        
-        if (baseLatency > 0) {
+
+        if (delay > 0) {
             if (decision.action == AnomalyDecision::Action::Forward) {
                 decision.action = AnomalyDecision::Action::Delay;
             }
-            decision.delayMs = baseLatency;
+            // Reorder keeps its action; the held segment still gets the delay
+            decision.delayUs = static_cast<uint32_t>(delay) * p.delayUnitUs;
         }
     }
 
     // Check throttle
-    if (dirProfile.throttleKbps > 0) {
+    if (p.faults & DirectionPlan::THROTTLE) {
         if (decision.action == AnomalyDecision::Action::Forward) {
             decision.action = AnomalyDecision::Action::Throttle;
         }
-        decision.throttleBytesPerSec = dirProfile.throttleKbps * 1024 / 8;
+        decision.throttleBytesPerSec = p.throttleBytesPerSec;
     }
 
     return decision;
 }
 
+const DirectionPlan& directionPlan(const DecisionPlan& plan, Direction direction) noexcept {
+    return direction == Direction::ClientToServer ? plan.clientToServer : plan.serverToClient;
+}
+
+} // namespace
+
+AnomalyDecision AnomalyEngine::decide(
+    std::span<const uint8_t> data,
+    Direction direction,
+    uint64_t sessionId,
+    uint64_t packetSeq,
+    const DecisionPlan& plan,
+    DecisionState* state
+) const {
+    const DirectionPlan& p = directionPlan(plan, direction);
+    if (p.faults == 0) {
+        return AnomalyDecision{};  // Fault-free direction: forward, no hashing
+    }
+
+    // Different sub-seeds per decision type keep decisions independent
+    uint8_t dir = static_cast<uint8_t>(direction);
+    uint64_t key = DeterministicRng::sessionKey(globalSeed_, sessionId);
+    return decideWith(p, data.size(), maxStallMs_, state, [&](Roll r) {
+        return DeterministicRng::hashFrom(key, rollSeq(r, packetSeq), rollDir(r, dir));
+    });
+}
+
+void AnomalyEngine::decideBatch(
+    std::span<const DecisionInput> inputs,
+    const DecisionPlan& plan,
+    std::span<AnomalyDecision> out
+) const {
+    if ((plan.clientToServer.faults | plan.serverToClient.faults) == 0) {
+        std::fill_n(out.begin(), inputs.size(), AnomalyDecision{});
+        return;
+    }
+
+#if SHAKYLINE_HAVE_AVX2_DISPATCH
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    if (avx2) {
+        decideBatchAvx2(inputs, plan, out);
+        return;
+    }
+#endif
+    decideBatchScalar(inputs, plan, out);
+}
+
+void AnomalyEngine::decideBatchScalar(
+    std::span<const DecisionInput> inputs,
+    const DecisionPlan& plan,
+    std::span<AnomalyDecision> out
+) const {
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        const DecisionInput& in = inputs[i];
+        const DirectionPlan& p = directionPlan(plan, in.direction);
+        if (p.faults == 0) {
+            out[i] = AnomalyDecision{};
+            continue;
+        }
+        uint8_t dir = static_cast<uint8_t>(in.direction);
+        uint64_t key = DeterministicRng::sessionKey(globalSeed_, in.sessionId);
+        out[i] = decideWith(p, in.length, maxStallMs_, in.state, [&](Roll r) {
+            return DeterministicRng::hashFrom(key, rollSeq(r, in.packetSeq), rollDir(r, dir));
+        });
+    }
+}
+
+#if SHAKYLINE_HAVE_AVX2_DISPATCH
+
+namespace {
+
+// 64-bit lane multiply from 32-bit halves (AVX2 has no vpmullq):
+// lo(a)*lo(b) + ((hi(a)*lo(b) + lo(a)*hi(b)) << 32)
+__attribute__((target("avx2")))
+inline __m256i mul64(__m256i a, __m256i b) {
+    __m256i lo = _mm256_mul_epu32(a, b);
+    __m256i cross = _mm256_add_epi64(
+        _mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+        _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+    return _mm256_add_epi64(lo, _mm256_slli_epi64(cross, 32));
+}
+
+__attribute__((target("avx2")))
+inline __m256i splitmix64x4(__m256i z) {
+    z = _mm256_add_epi64(z, _mm256_set1_epi64x(static_cast<long long>(0x9e3779b97f4a7c15ULL)));
+    z = mul64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 30)),
+              _mm256_set1_epi64x(static_cast<long long>(0xbf58476d1ce4e5b9ULL)));
+    z = mul64(_mm256_xor_si256(z, _mm256_srli_epi64(z, 27)),
+              _mm256_set1_epi64x(static_cast<long long>(0x94d049bb133111ebULL)));
+    return _mm256_xor_si256(z, _mm256_srli_epi64(z, 31));
+}
+
+} // namespace
+
+__attribute__((target("avx2")))
+void AnomalyEngine::decideBatchAvx2(
+    std::span<const DecisionInput> inputs,
+    const DecisionPlan& plan,
+    std::span<AnomalyDecision> out
+) const {
+    constexpr std::size_t LANES = 4;
+    uint32_t rolls = rollsNeeded(plan.clientToServer) | rollsNeeded(plan.serverToClient);
+    const __m256i global = _mm256_set1_epi64x(static_cast<long long>(globalSeed_));
+
+    alignas(32) uint64_t hashes[ROLL_COUNT][LANES];
+
+    std::size_t i = 0;
+    for (; i + LANES <= inputs.size(); i += LANES) {
+        // Lanes built from registers: a wide load of four narrow stores would
+        // miss store forwarding
+        const DecisionInput* in = &inputs[i];
+        __m256i session = _mm256_set_epi64x(
+            static_cast<long long>(in[3].sessionId), static_cast<long long>(in[2].sessionId),
+            static_cast<long long>(in[1].sessionId), static_cast<long long>(in[0].sessionId));
+        __m256i seq = _mm256_set_epi64x(
+            static_cast<long long>(in[3].packetSeq), static_cast<long long>(in[2].packetSeq),
+            static_cast<long long>(in[1].packetSeq), static_cast<long long>(in[0].packetSeq));
+        __m256i dir = _mm256_set_epi64x(
+            static_cast<long long>(in[3].direction), static_cast<long long>(in[2].direction),
+            static_cast<long long>(in[1].direction), static_cast<long long>(in[0].direction));
+        __m256i key = splitmix64x4(_mm256_xor_si256(global, session));
+        __m256i seq7 = _mm256_sub_epi64(_mm256_slli_epi64(seq, 3), seq);
+
+        for (unsigned r = 0; r < ROLL_COUNT; ++r) {
+            if (!(rolls & (1u << r))) continue;
+            Roll roll = static_cast<Roll>(r);
+            __m256i rollSeqV = roll < ROLL_REORDER
+                ? _mm256_add_epi64(seq7, _mm256_set1_epi64x(r + 1))
+                : seq;
+            // rollDir() is dir | (stream << 1): the same OR for every lane
+            __m256i rollDirV = _mm256_or_si256(dir, _mm256_set1_epi64x(rollDir(roll, 0)));
+            __m256i h = splitmix64x4(_mm256_xor_si256(key, rollSeqV));
+            h = splitmix64x4(_mm256_xor_si256(h, rollDirV));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(hashes[r]), h);
+        }
+
+        for (std::size_t l = 0; l < LANES; ++l) {
+            const DirectionPlan& p = directionPlan(plan, in[l].direction);
+            if (p.faults == 0) {
+                out[i + l] = AnomalyDecision{};
+                continue;
+            }
+            out[i + l] = decideWith(p, in[l].length, maxStallMs_, in[l].state, [&](Roll r) {
+                if (rolls & (1u << r)) return hashes[r][l];
+                return DeterministicRng::hashFrom(
+                    DeterministicRng::sessionKey(globalSeed_, in[l].sessionId),
+                    rollSeq(r, in[l].packetSeq),
+                    rollDir(r, static_cast<uint8_t>(in[l].direction)));
+            });
+        }
+    }
+
+    // Tail of fewer than four packets
+    decideBatchScalar(inputs.subspan(i), plan, out.subspan(i));
+}
+
+#endif
+
 void AnomalyEngine::applyCorruption(
     std::span<uint8_t> data,
     std::size_t offset,
@@ -106,13 +334,4 @@ void AnomalyEngine::applyCorruption(
     }
 }
 
-const DirectionalProfile& AnomalyEngine::getDirectionalProfile(
-    Direction direction,
-    const AnomalyProfile& profile
-) const {
-    return (direction == Direction::ClientToServer) 
-           ? profile.clientToServer 
-           : profile.serverToClient;
-}
-
 } // namespace shakyline
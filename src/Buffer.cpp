@@ -1,24 +1,51 @@
 #include "shakyline/Buffer.hpp"
+#include "shakyline/BufferPool.hpp"
 
 namespace shakyline {
 
 Buffer::Buffer(std::size_t capacity)
-    : data_(capacity)
-    , capacity_(capacity) {}
+    : capacity_(capacity) {}
 
-std::size_t Buffer::append(const uint8_t* data, std::size_t len) {
-    if (len == 0) return 0;
-    
-    // Compact if needed to make space
-    if (writePos_ + len > capacity_ && readPos_ > 0) {
-        compact();
+Buffer::~Buffer() {
+    releaseStorage();
+}
+
+Buffer::Buffer(Buffer&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , storageSize_(std::exchange(other.storageSize_, 0))
+    , capacity_(other.capacity_)
+    , readPos_(std::exchange(other.readPos_, 0))
+    , size_(std::exchange(other.size_, 0))
+    , sending_(std::exchange(other.sending_, false)) {}
+
+Buffer& Buffer::operator=(Buffer&& other) noexcept {
+    if (this != &other) {
+        releaseStorage();
+        data_ = std::exchange(other.data_, nullptr);
+        storageSize_ = std::exchange(other.storageSize_, 0);
+        capacity_ = other.capacity_;
+        readPos_ = std::exchange(other.readPos_, 0);
+        size_ = std::exchange(other.size_, 0);
+        sending_ = std::exchange(other.sending_, false);
     }
+    return *this;
+}
 
-    std::size_t toWrite = std::min(len, capacity_ - writePos_);
+std::size_t Buffer::append(const uint8_t* data, std::size_t len) {
+    std::size_t toWrite = std::min(len, writable());
     if (toWrite == 0) return 0;
 
-    std::memcpy(data_.data() + writePos_, data, toWrite);
-    writePos_ += toWrite;
+    reserve(size_ + toWrite);
+    toWrite = std::min(toWrite, storageSize_ - size_);
+    if (toWrite == 0) return 0;
+
+    // Copy up to the end of storage, then wrap to the front
+    std::size_t tail = tailPos();
+    std::size_t first = std::min(toWrite, storageSize_ - tail);
+    std::memcpy(data_ + tail, data, first);
+    if (toWrite > first) {
+        std::memcpy(data_, data + first, toWrite - first);
+    }
     size_ += toWrite;
     return toWrite;
 }
@@ -26,12 +53,13 @@ std::size_t Buffer::append(const uint8_t* data, std::size_t len) {
 std::size_t Buffer::consume(std::size_t len) {
     std::size_t toConsume = std::min(len, size_);
     readPos_ += toConsume;
+    if (readPos_ >= storageSize_) readPos_ -= storageSize_;
     size_ -= toConsume;
+    sending_ = false;
     
-    // Reset positions if empty
+    // Drained: hand storage back so idle directions hold no memory
     if (size_ == 0) {
-        readPos_ = 0;
-        writePos_ = 0;
+        releaseStorage();
     }
     
     return toConsume;
@@ -42,43 +70,81 @@ std::size_t Buffer::peek(const uint8_t** outData) const noexcept {
         *outData = nullptr;
         return 0;
     }
-    *outData = data_.data() + readPos_;
-    return size_;
+    *outData = data_ + readPos_;
+    return std::min(size_, storageSize_ - readPos_);
 }
 
 asio::mutable_buffer Buffer::prepareWrite(std::size_t maxBytes) {
-    // Compact if needed
-    if (writePos_ + maxBytes > capacity_ && readPos_ > 0) {
-        compact();
+    maxBytes = std::min(maxBytes, writable());
+    if (maxBytes == 0) {
+        return asio::mutable_buffer(data_, 0);
     }
-    
-    std::size_t available = capacity_ - writePos_;
-    std::size_t toReserve = std::min(maxBytes, available);
-    return asio::mutable_buffer(data_.data() + writePos_, toReserve);
+
+    reserve(size_ + maxBytes);
+    if (size_ >= storageSize_) {
+        return asio::mutable_buffer(data_, 0);
+    }
+
+    // Free space is [tail, readPos) modulo storage; hand out its first run
+    std::size_t tail = tailPos();
+    std::size_t contiguous = (tail >= readPos_) ? storageSize_ - tail : readPos_ - tail;
+    return asio::mutable_buffer(data_ + tail, std::min(maxBytes, contiguous));
 }
 
 void Buffer::commitWrite(std::size_t bytesWritten) {
-    writePos_ += bytesWritten;
-    size_ += bytesWritten;
+    size_ += std::min(bytesWritten, storageSize_ - size_);
+}
+
+Buffer::ConstBuffers Buffer::dataToSend() {
+    sending_ = true;
+    std::size_t first = std::min(size_, storageSize_ - readPos_);
+    return {
+        asio::const_buffer(data_ + readPos_, first),
+        asio::const_buffer(data_, size_ - first)
+    };
 }
 
-asio::const_buffer Buffer::dataToSend() const {
-    return asio::const_buffer(data_.data() + readPos_, size_);
+void Buffer::trim() noexcept {
+    if (size_ == 0) {
+        releaseStorage();
+    }
 }
 
 void Buffer::clear() noexcept {
     readPos_ = 0;
-    writePos_ = 0;
     size_ = 0;
+    if (!sending_) {
+        releaseStorage();
+    }
 }
 
-void Buffer::compact() {
-    if (readPos_ == 0) return;
-    
+bool Buffer::reserve(std::size_t needed) {
+    needed = std::min(needed, capacity_);
+    if (needed <= storageSize_) return true;
+    // An in-flight write still points at the current storage
+    if (sending_) return false;
+
+    std::size_t newSize = 0;
+    uint8_t* block = BufferPool::local().acquire(needed, newSize);
+
+    // Linearize existing bytes into the new block (rare: class upgrade)
     if (size_ > 0) {
-        std::memmove(data_.data(), data_.data() + readPos_, size_);
+        std::size_t first = std::min(size_, storageSize_ - readPos_);
+        std::memcpy(block, data_ + readPos_, first);
+        std::memcpy(block + first, data_, size_ - first);
     }
-    writePos_ = size_;
+    releaseStorage();
+    data_ = block;
+    storageSize_ = newSize;
+    readPos_ = 0;
+    return true;
+}
+
+void Buffer::releaseStorage() noexcept {
+    if (!data_) return;
+    BufferPool::local().release(data_, storageSize_);
+    data_ = nullptr;
+    storageSize_ = 0;
     readPos_ = 0;
 }
 
@@ -0,0 +1,67 @@
+#include "shakyline/BufferPool.hpp"
+
+namespace shakyline {
+
+BufferPool::~BufferPool() {
+    for (auto& list : freeLists_) {
+        for (uint8_t* block : list) {
+            delete[] block;
+        }
+    }
+}
+
+BufferPool& BufferPool::local() {
+    thread_local BufferPool pool;
+    return pool;
+}
+
+uint8_t* BufferPool::acquire(std::size_t minSize, std::size_t& actualSize) {
+    for (std::size_t i = 0; i < SIZE_CLASSES.size(); ++i) {
+        if (minSize > SIZE_CLASSES[i]) continue;
+
+        actualSize = SIZE_CLASSES[i];
+        auto& list = freeLists_[i];
+        if (!list.empty()) {
+            uint8_t* block = list.back();
+            list.pop_back();
+            return block;
+        }
+        return new uint8_t[actualSize];
+    }
+
+    // Oversized: not pooled
+    actualSize = minSize;
+    return new uint8_t[actualSize];
+}
+
+void BufferPool::release(uint8_t* block, std::size_t size) noexcept {
+    if (!block) return;
+
+    int idx = classIndex(size);
+    if (idx >= 0 && freeLists_[idx].size() < MAX_CACHED_PER_CLASS) {
+        try {
+            freeLists_[idx].push_back(block);
+            return;
+        } catch (...) {
+            // Fall through and free it
+        }
+    }
+    delete[] block;
+}
+
+std::size_t BufferPool::cachedBlocks() const noexcept {
+    std::size_t total = 0;
+    for (const auto& list : freeLists_) {
+        total += list.size();
+    }
+    return total;
+}
+
+int BufferPool::classIndex(std::size_t size) noexcept {
+    for (std::size_t i = 0; i < SIZE_CLASSES.size(); ++i) {
+        if (SIZE_CLASSES[i] == size) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+} // namespace shakyline
@@ -1,5 +1,12 @@
 #include "shakyline/Config.hpp"
+#include "shakyline/DecisionPlan.hpp"
+#include "shakyline/LatencyTrace.hpp"
+#include "shakyline/Logger.hpp"
 #include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <filesystem>
+#include <stdexcept>
 
 namespace shakyline {
 
@@ -9,23 +16,122 @@ AnomalyProfile ConfigManager::getProfile(const std::string& name) const {
     if (it == profiles_.end()) {
         return AnomalyProfile{};  // Return default profile
     }
+    return it->second->profile;
+}
+
+std::shared_ptr<const DecisionPlan> ConfigManager::getPlan(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = profiles_.find(name);
+    if (it == profiles_.end()) {
+        return DecisionPlan::empty();
+    }
     return it->second;
 }
 
 uint32_t ConfigManager::setProfile(const std::string& name, AnomalyProfile profile) {
-    std::unique_lock<std::shared_mutex> lock(mutex_);
-    
     profile.clientToServer = validate(profile.clientToServer);
     profile.serverToClient = validate(profile.serverToClient);
     profile.version = nextVersion_.fetch_add(1);
-    
-    profiles_[name] = profile;
+
+    // Compiled outside mutex_; sessions pick it up on the next generation
+    std::lock_guard<std::mutex> writer(writeMutex_);
+    auto plan = compile(profile);
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    profiles_[name] = std::move(plan);
+    generation_.fetch_add(1, std::memory_order_release);
     return profile.version;
 }
 
 bool ConfigManager::deleteProfile(const std::string& name) {
+    std::lock_guard<std::mutex> writer(writeMutex_);
     std::unique_lock<std::shared_mutex> lock(mutex_);
-    return profiles_.erase(name) > 0;
+    if (profiles_.erase(name) == 0) return false;
+    generation_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
+std::shared_ptr<const DecisionPlan> ConfigManager::compile(const AnomalyProfile& profile) const {
+    auto resolve = [this](const std::string& name) -> std::shared_ptr<const LatencyTrace> {
+        if (name.empty()) return nullptr;
+        auto it = traces_.find(name);
+        if (it == traces_.end()) {
+            throw std::invalid_argument("unknown delay trace: " + name);
+        }
+        return it->second;
+    };
+    return DecisionPlan::compile(profile, resolve(profile.clientToServer.delayTrace),
+                                 resolve(profile.serverToClient.delayTrace));
+}
+
+uint64_t ConfigManager::setTrace(const std::string& name, std::string_view samples) {
+    // Names become file names
+    bool valid = !name.empty() && name[0] != '.' &&
+                 std::all_of(name.begin(), name.end(), [](char c) {
+                     return std::isalnum(static_cast<unsigned char>(c)) ||
+                            c == '_' || c == '-' || c == '.';
+                 });
+    if (!valid) {
+        throw std::invalid_argument("bad trace name: " + name);
+    }
+
+    std::string path;
+    if (!serverConfig_.traceDir.empty()) {
+        path = serverConfig_.traceDir + "/" + name + LatencyTrace::FILE_SUFFIX;
+    }
+    auto trace = LatencyTrace::build(samples, path);
+
+    std::lock_guard<std::mutex> writer(writeMutex_);
+    traces_[name] = trace;
+
+    // Profiles that name the trace move to the new samples
+    std::vector<std::pair<std::string, std::shared_ptr<const DecisionPlan>>> updated;
+    for (const auto& [profileName, plan] : profiles_) {
+        if (plan->profile.clientToServer.delayTrace == name ||
+            plan->profile.serverToClient.delayTrace == name) {
+            updated.emplace_back(profileName, compile(plan->profile));
+        }
+    }
+    if (!updated.empty()) {
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (auto& [profileName, plan] : updated) {
+            profiles_[profileName] = std::move(plan);
+        }
+        generation_.fetch_add(1, std::memory_order_release);
+    }
+    return trace->sampleCount();
+}
+
+bool ConfigManager::deleteTrace(const std::string& name) {
+    std::lock_guard<std::mutex> writer(writeMutex_);
+    if (traces_.erase(name) == 0) return false;
+    if (!serverConfig_.traceDir.empty()) {
+        std::string path = serverConfig_.traceDir + "/" + name + LatencyTrace::FILE_SUFFIX;
+        std::remove(path.c_str());
+    }
+    return true;
+}
+
+std::size_t ConfigManager::loadTraces() {
+    if (serverConfig_.traceDir.empty()) return 0;
+
+    std::lock_guard<std::mutex> writer(writeMutex_);
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator(serverConfig_.traceDir, ec)) {
+        const auto& path = entry.path();
+        if (path.extension() != LatencyTrace::FILE_SUFFIX) continue;
+        try {
+            traces_[path.stem().string()] = LatencyTrace::open(path.string());
+        } catch (const std::exception& e) {
+            globalLogger().warn(0, 0, "trace_load_failed", "",
+                                "path=" + path.string() + " error=" + e.what());
+        }
+    }
+    if (ec) {
+        globalLogger().warn(0, 0, "trace_load_failed", "",
+                            "dir=" + serverConfig_.traceDir + " error=" + ec.message());
+    }
+    return traces_.size();
 }
 
 bool ConfigManager::checkRateLimit() {
@@ -53,11 +159,20 @@ DirectionalProfile ConfigManager::validate(const DirectionalProfile& profile) {
     
     validated.latencyMs = std::min(validated.latencyMs, ConfigLimits::MAX_LATENCY_MS);
     validated.jitterMs = std::min(validated.jitterMs, ConfigLimits::MAX_JITTER_MS);
+    validated.latencyUs = std::min(validated.latencyUs, ConfigLimits::MAX_LATENCY_US);
+    validated.jitterUs = std::min(validated.jitterUs, ConfigLimits::MAX_JITTER_US);
+    validated.delayCorrelation = std::clamp(validated.delayCorrelation, 0.0f, ConfigLimits::MAX_RATE);
     validated.throttleKbps = std::min(validated.throttleKbps, ConfigLimits::MAX_THROTTLE_KBPS);
     validated.dropRate = std::clamp(validated.dropRate, 0.0f, ConfigLimits::MAX_RATE);
+    validated.burstEnterRate = std::clamp(validated.burstEnterRate, 0.0f, ConfigLimits::MAX_RATE);
+    validated.burstExitRate = std::clamp(validated.burstExitRate, 0.0f, ConfigLimits::MAX_RATE);
+    validated.burstLossGood = std::clamp(validated.burstLossGood, 0.0f, ConfigLimits::MAX_RATE);
+    validated.burstLossBad = std::clamp(validated.burstLossBad, 0.0f, ConfigLimits::MAX_RATE);
     validated.stallProbability = std::clamp(validated.stallProbability, 0.0f, ConfigLimits::MAX_RATE);
     validated.corruptRate = std::clamp(validated.corruptRate, 0.0f, ConfigLimits::MAX_RATE);
     validated.reorderRate = std::clamp(validated.reorderRate, 0.0f, ConfigLimits::MAX_RATE);
+    validated.reorderDistance = std::clamp(validated.reorderDistance, 1u,
+                                           ConfigLimits::MAX_REORDER_DISTANCE);
     validated.halfCloseRate = std::clamp(validated.halfCloseRate, 0.0f, ConfigLimits::MAX_RATE);
     
     return validated;
@@ -1,17 +1,19 @@
 #include "shakyline/ControlServer.hpp"
 #include "shakyline/Logger.hpp"
 
+#include <chrono>
 #include <sstream>
 #include <regex>
+#include <stdexcept>
 
 namespace shakyline {
 
 ControlServer::ControlServer(
     ConfigManager& config,
-    SessionManager::Ptr sessionManager,
+    std::vector<SessionManager::Ptr> sessionManagers,
     uint16_t port
 ) : config_(config)
-  , sessionManager_(std::move(sessionManager))
+  , sessionManagers_(std::move(sessionManagers))
   , port_(port)
 {}
 
@@ -136,6 +138,18 @@ std::string ControlServer::handleRequest(const std::string& method,
         return handleGetSessions();
     }
     
+    // Trace routes: /traces/{name}
+    std::regex traceRegex("/traces/([^/]+)");
+    std::smatch traceMatch;
+    if (std::regex_match(path, traceMatch, traceRegex)) {
+        std::string name = traceMatch[1];
+        if (method == "POST") {
+            return handlePostTrace(name, body);
+        } else if (method == "DELETE") {
+            return handleDeleteTrace(name);
+        }
+    }
+
     // Profile routes: /profiles/{name}
     std::regex profileRegex("/profiles/([^/]+)");
     std::smatch match;
@@ -152,7 +166,7 @@ std::string ControlServer::handleRequest(const std::string& method,
 }
 
 std::string ControlServer::handleGetHealth() {
-    bool healthy = sessionManager_ != nullptr;
+    bool healthy = !sessionManagers_.empty();
     if (healthy) {
         return makeResponse(200, "application/json", "{\"status\":\"ok\"}");
     } else {
@@ -166,7 +180,11 @@ std::string ControlServer::handleGetMetrics() {
 }
 
 std::string ControlServer::handleGetSessions() {
-    auto ids = sessionManager_->getSessionIds();
+    std::vector<uint64_t> ids;
+    for (const auto& manager : sessionManagers_) {
+        auto shardIds = manager->getSessionIds();
+        ids.insert(ids.end(), shardIds.begin(), shardIds.end());
+    }
     
     std::ostringstream oss;
     oss << "{\"sessions\":[";
@@ -193,20 +211,52 @@ std::string ControlServer::handlePostProfile(const std::string& name,
             std::string val = parseJson(body, key);
             return val.empty() ? 0.0f : std::stof(val);
         };
+        auto parseDistribution = [&](const std::string& key) -> DelayDistribution {
+            std::string val = parseJson(body, key);
+            if (val.empty() || val == "uniform") return DelayDistribution::Uniform;
+            if (val == "normal") return DelayDistribution::Normal;
+            if (val == "pareto") return DelayDistribution::Pareto;
+            if (val == "paretonormal") return DelayDistribution::ParetoNormal;
+            throw std::invalid_argument("unknown " + key + ": " + val);
+        };
 
         // Client to server
         profile.clientToServer.latencyMs = parseUint("c2s_latency_ms");
         profile.clientToServer.jitterMs = parseUint("c2s_jitter_ms");
+        profile.clientToServer.latencyUs = parseUint("c2s_latency_us");
+        profile.clientToServer.jitterUs = parseUint("c2s_jitter_us");
+        profile.clientToServer.delayDistribution = parseDistribution("c2s_delay_distribution");
+        profile.clientToServer.delayCorrelation = parseFloat("c2s_delay_correlation");
+        profile.clientToServer.delayTrace = parseJson(body, "c2s_delay_trace");
         profile.clientToServer.throttleKbps = parseUint("c2s_throttle_kbps");
         profile.clientToServer.dropRate = parseFloat("c2s_drop_rate");
+        profile.clientToServer.burstEnterRate = parseFloat("c2s_burst_p");
+        profile.clientToServer.burstExitRate = parseFloat("c2s_burst_r");
+        profile.clientToServer.burstLossGood = parseFloat("c2s_burst_loss_good");
+        profile.clientToServer.burstLossBad = parseFloat("c2s_burst_loss_bad");
         profile.clientToServer.stallProbability = parseFloat("c2s_stall_prob");
+        profile.clientToServer.stallMs = parseUint("c2s_stall_ms");
+        profile.clientToServer.reorderRate = parseFloat("c2s_reorder_rate");
+        profile.clientToServer.reorderDistance = parseUint("c2s_reorder_distance");
 
         // Server to client
         profile.serverToClient.latencyMs = parseUint("s2c_latency_ms");
         profile.serverToClient.jitterMs = parseUint("s2c_jitter_ms");
+        profile.serverToClient.latencyUs = parseUint("s2c_latency_us");
+        profile.serverToClient.jitterUs = parseUint("s2c_jitter_us");
+        profile.serverToClient.delayDistribution = parseDistribution("s2c_delay_distribution");
+        profile.serverToClient.delayCorrelation = parseFloat("s2c_delay_correlation");
+        profile.serverToClient.delayTrace = parseJson(body, "s2c_delay_trace");
         profile.serverToClient.throttleKbps = parseUint("s2c_throttle_kbps");
         profile.serverToClient.dropRate = parseFloat("s2c_drop_rate");
+        profile.serverToClient.burstEnterRate = parseFloat("s2c_burst_p");
+        profile.serverToClient.burstExitRate = parseFloat("s2c_burst_r");
+        profile.serverToClient.burstLossGood = parseFloat("s2c_burst_loss_good");
+        profile.serverToClient.burstLossBad = parseFloat("s2c_burst_loss_bad");
         profile.serverToClient.stallProbability = parseFloat("s2c_stall_prob");
+        profile.serverToClient.stallMs = parseUint("s2c_stall_ms");
+        profile.serverToClient.reorderRate = parseFloat("s2c_reorder_rate");
+        profile.serverToClient.reorderDistance = parseUint("s2c_reorder_distance");
 
         // Also try simple top-level keys for convenience
         if (profile.clientToServer.latencyMs == 0) {
@@ -232,6 +282,37 @@ std::string ControlServer::handlePostProfile(const std::string& name,
     }
 }
 
+std::string ControlServer::handlePostTrace(const std::string& name, const std::string& body) {
+    try {
+        auto start = std::chrono::steady_clock::now();
+        uint64_t samples = config_.setTrace(name, body);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+
+        globalLogger().info(0, 0, "trace_updated", "",
+                           "name=" + name + " samples=" + std::to_string(samples) +
+                           " ms=" + std::to_string(elapsed.count()));
+
+        return makeResponse(200, "application/json",
+                           "{\"samples\":" + std::to_string(samples) +
+                           ",\"load_ms\":" + std::to_string(elapsed.count()) + "}");
+    } catch (const std::invalid_argument& e) {
+        return makeResponse(400, "application/json",
+                           "{\"error\":\"" + std::string(e.what()) + "\"}");
+    } catch (const std::exception& e) {
+        return makeResponse(500, "application/json",
+                           "{\"error\":\"" + std::string(e.what()) + "\"}");
+    }
+}
+
+std::string ControlServer::handleDeleteTrace(const std::string& name) {
+    if (config_.deleteTrace(name)) {
+        globalLogger().info(0, 0, "trace_deleted", "", "name=" + name);
+        return makeResponse(200, "application/json", "{\"deleted\":true}");
+    }
+    return makeResponse(404, "application/json", "{\"error\":\"not found\"}");
+}
+
 std::string ControlServer::handleDeleteProfile(const std::string& name) {
     bool deleted = config_.deleteProfile(name);
     if (deleted) {
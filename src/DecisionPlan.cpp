@@ -0,0 +1,102 @@
+#include "shakyline/DecisionPlan.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace shakyline {
+
+FastMod64::FastMod64(uint64_t divisor) noexcept
+    : d_(divisor) {
+#ifdef __SIZEOF_INT128__
+    __extension__ typedef unsigned __int128 u128;
+    u128 m = ~u128(0) / divisor + 1;
+    mLo_ = static_cast<uint64_t>(m);
+    mHi_ = static_cast<uint64_t>(m >> 64);
+#endif
+}
+
+std::shared_ptr<const DecisionPlan> DecisionPlan::compile(
+    const AnomalyProfile& profile,
+    std::shared_ptr<const LatencyTrace> clientToServerTrace,
+    std::shared_ptr<const LatencyTrace> serverToClientTrace) {
+    auto plan = std::make_shared<DecisionPlan>();
+    plan->profile = profile;
+    plan->clientToServer = compileDirection(profile.clientToServer, clientToServerTrace.get());
+    plan->serverToClient = compileDirection(profile.serverToClient, serverToClientTrace.get());
+    plan->clientToServerTrace = std::move(clientToServerTrace);
+    plan->serverToClientTrace = std::move(serverToClientTrace);
+    return plan;
+}
+
+const std::shared_ptr<const DecisionPlan>& DecisionPlan::empty() {
+    static const std::shared_ptr<const DecisionPlan> plan = compile(AnomalyProfile{});
+    return plan;
+}
+
+uint32_t DecisionPlan::threshold(float rate) noexcept {
+    if (!(rate > 0.0f)) return 0;  // Also NaN
+    // rate * 2^24 is exact in double; bits24 < x  <=>  bits24 < ceil(x)
+    double scaled = std::ceil(static_cast<double>(rate) * static_cast<double>(1u << 24));
+    return static_cast<uint32_t>(std::min(scaled, static_cast<double>(1u << 24)));
+}
+
+DirectionPlan DecisionPlan::compileDirection(const DirectionalProfile& p,
+                                            const LatencyTrace* trace) {
+    DirectionPlan plan;
+
+    auto roll = [&plan](float rate, uint32_t& threshold, DirectionPlan::Fault fault) {
+        threshold = DecisionPlan::threshold(rate);
+        if (threshold > 0) plan.faults |= fault;
+    };
+    roll(p.dropRate, plan.dropThreshold, DirectionPlan::DROP);
+    roll(p.halfCloseRate, plan.halfCloseThreshold, DirectionPlan::HALF_CLOSE);
+    roll(p.stallProbability, plan.stallThreshold, DirectionPlan::STALL);
+    roll(p.corruptRate, plan.corruptThreshold, DirectionPlan::CORRUPT);
+    roll(p.reorderRate, plan.reorderThreshold, DirectionPlan::REORDER);
+    plan.stallMs = p.stallMs;
+
+    if (p.burstLoss()) {
+        plan.faults |= DirectionPlan::BURST_LOSS;
+        plan.burstEnterThreshold = threshold(p.burstEnterRate);
+        plan.burstExitThreshold = threshold(p.burstExitRate);
+        plan.burstLossThreshold[0] = threshold(p.burstLossGood);
+        plan.burstLossThreshold[1] = threshold(p.burstLossBad);
+    }
+
+    if (p.preciseLatency()) {
+        plan.delayBase = p.latencyMs * 1000 + p.latencyUs;
+        plan.delayJitter = p.jitterMs * 1000 + p.jitterUs;
+        plan.delayUnitUs = 1;
+    } else {
+        plan.delayBase = p.latencyMs;
+        plan.delayJitter = p.jitterMs;
+    }
+    if (trace) {
+        plan.delayTrace = trace;  // In µs: preciseLatency() holds for trace profiles
+        plan.delayJitter = 0;
+    }
+    if (plan.delayBase > 0 || plan.delayJitter > 0 || plan.delayTrace) {
+        plan.faults |= DirectionPlan::DELAY;
+    }
+    plan.jitterMod = FastMod64(uint64_t(plan.delayJitter) * 2 + 1);
+
+    // A tail draw must not hold the in-order queue (and the stream) for minutes
+    uint64_t limit = uint64_t(ConfigLimits::MAX_DELAY_MS) * 1000 / plan.delayUnitUs;
+    uint64_t shaped = plan.delayBase +
+                      uint64_t(ConfigLimits::MAX_JITTER_DEVIATIONS) * plan.delayJitter;
+    plan.delayMax = static_cast<uint32_t>(trace ? limit : std::min(shaped, limit));
+    if (!trace &&
+        (p.delayDistribution != DelayDistribution::Uniform || p.delayCorrelation > 0.0f)) {
+        plan.delayTable = &DelayTable::get(p.delayDistribution);
+        plan.delayKeep = p.delayCorrelation;
+        plan.delayFresh = std::sqrt(1.0f - p.delayCorrelation * p.delayCorrelation);
+    }
+
+    plan.throttleBytesPerSec = p.throttleKbps * 1000 / 8;  // Network kbps are decimal
+    if (plan.throttleBytesPerSec > 0) {
+        plan.faults |= DirectionPlan::THROTTLE;
+    }
+    return plan;
+}
+
+} // namespace shakyline
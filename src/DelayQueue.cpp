@@ -1,76 +1,303 @@
 #include "shakyline/DelayQueue.hpp"
-#include <optional>
+#include "shakyline/BufferPool.hpp"
+#include "shakyline/SpillStore.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
 
 namespace shakyline {
 
-bool DelayQueue::push(std::vector<uint8_t> payload,
+DelayQueue::~DelayQueue() {
+    clear();
+}
+
+DelayQueue::DelayQueue(DelayQueue&& other) noexcept
+    : fifo_(std::move(other.fifo_))
+    , fifoHead_(std::exchange(other.fifoHead_, 0))
+    , fifoCount_(std::exchange(other.fifoCount_, 0))
+    , lastRelease_(other.lastRelease_)
+    , chunks_(std::move(other.chunks_))
+    , tailChunk_(std::exchange(other.tailChunk_, NO_CHUNK))
+    , spillTail_(std::exchange(other.spillTail_, NO_CHUNK))
+    , spill_(std::move(other.spill_))
+    , totalBytes_(std::exchange(other.totalBytes_, 0))
+    , memoryBytes_(std::exchange(other.memoryBytes_, 0)) {
+    other.chunks_.clear();
+}
+
+DelayQueue& DelayQueue::operator=(DelayQueue&& other) noexcept {
+    if (this != &other) {
+        clear();
+        fifo_ = std::move(other.fifo_);
+        fifoHead_ = std::exchange(other.fifoHead_, 0);
+        fifoCount_ = std::exchange(other.fifoCount_, 0);
+        lastRelease_ = other.lastRelease_;
+        chunks_ = std::move(other.chunks_);
+        other.chunks_.clear();
+        tailChunk_ = std::exchange(other.tailChunk_, NO_CHUNK);
+        spillTail_ = std::exchange(other.spillTail_, NO_CHUNK);
+        spill_ = std::move(other.spill_);
+        totalBytes_ = std::exchange(other.totalBytes_, 0);
+        memoryBytes_ = std::exchange(other.memoryBytes_, 0);
+    }
+    return *this;
+}
+
+bool DelayQueue::push(std::span<const uint8_t> payload,
                       std::chrono::steady_clock::time_point releaseTime,
                       uint64_t packetSeq,
                       uint32_t profileVersion,
                       uint8_t direction) {
     std::size_t payloadSize = payload.size();
-    
-    // Drop oldest if exceeding limit
-    while (totalBytes_ + payloadSize > MAX_BYTES && !queue_.empty()) {
-        dropOldest();
+    uint32_t offset = 0;
+    uint32_t chunk = NO_CHUNK;
+
+    // Memory budget used up: overflow to the spill file while it has room
+    if (memoryBytes_ + payloadSize > MAX_BYTES && payloadSize <= SpillStore::SEGMENT_SIZE) {
+        chunk = allocate(payloadSize, true, offset);
     }
 
-    // Still can't fit (single packet too large)
-    if (payloadSize > MAX_BYTES) {
-        return false;
+    if (chunk == NO_CHUNK) {
+        // Drop oldest if exceeding limit
+        while (memoryBytes_ + payloadSize > MAX_BYTES && !empty()) {
+            dropOldest();
+        }
+
+        // Still can't fit (single packet too large)
+        if (payloadSize > MAX_BYTES) {
+            return false;
+        }
+
+        chunk = allocate(payloadSize, false, offset);
+        memoryBytes_ += payloadSize;
     }
+    std::memcpy(chunks_[chunk].data + offset, payload.data(), payloadSize);
 
-    DelayedPacket pkt{
-        std::move(payload),
+    totalBytes_ += payloadSize;
+    enqueue(DelayedPacket{
         releaseTime,
         packetSeq,
+        chunk,
+        offset,
+        static_cast<uint32_t>(payloadSize),
+        profileVersion,
+        direction
+    });
+    return true;
+}
+
+std::optional<DelayedPacket> DelayQueue::stash(std::span<const uint8_t> payload,
+                                               uint64_t packetSeq,
+                                               uint32_t profileVersion,
+                                               uint8_t direction) {
+    if (payload.size() > MAX_BYTES) {
+        return std::nullopt;
+    }
+
+    uint32_t offset = 0;
+    uint32_t chunk = allocate(payload.size(), false, offset);
+    std::memcpy(chunks_[chunk].data + offset, payload.data(), payload.size());
+    totalBytes_ += payload.size();
+    memoryBytes_ += payload.size();
+
+    return DelayedPacket{
+        std::chrono::steady_clock::time_point::max(),
+        packetSeq,
+        chunk,
+        offset,
+        static_cast<uint32_t>(payload.size()),
         profileVersion,
         direction
     };
+}
 
-    totalBytes_ += payloadSize;
-    queue_.push(std::move(pkt));
-    return true;
+void DelayQueue::enqueueStashed(DelayedPacket pkt,
+                                std::chrono::steady_clock::time_point releaseTime) {
+    pkt.releaseTime = releaseTime;
+    enqueue(pkt);
 }
 
 bool DelayQueue::hasReady(std::chrono::steady_clock::time_point now) const noexcept {
-    if (queue_.empty()) return false;
-    return queue_.top().releaseTime <= now;
+    const DelayedPacket* next = front();
+    return next && next->releaseTime <= now;
 }
 
-std::optional<DelayedPacket> DelayQueue::popReady(std::chrono::steady_clock::time_point now) {
-    if (queue_.empty() || queue_.top().releaseTime > now) {
+std::optional<DelayedPacket> DelayQueue::popReady(std::chrono::steady_clock::time_point now,
+                                                  std::size_t maxLength) {
+    const DelayedPacket* next = front();
+    if (!next || next->releaseTime > now || next->length > maxLength) {
         return std::nullopt;
     }
 
-    // Priority queue doesn't have a non-const top + pop combo
-    // We need to copy here (or use a different container)
-    DelayedPacket pkt = std::move(const_cast<DelayedPacket&>(queue_.top()));
-    queue_.pop();
-    totalBytes_ -= pkt.payload.size();
+    // Descriptors are small: copy out, payload stays put in the arena
+    DelayedPacket pkt = popFront();
+    unaccount(pkt);
     return pkt;
 }
 
+void DelayQueue::release(const DelayedPacket& pkt) noexcept {
+    if (pkt.chunk >= chunks_.size() || !chunks_[pkt.chunk].data) return;  // Cleared
+
+    Chunk& chunk = chunks_[pkt.chunk];
+    if (--chunk.live == 0) {
+        if (pkt.chunk == tailChunk_) {
+            chunk.used = 0;  // Keep the tail for reuse; rewind instead
+        } else {
+            releaseChunk(pkt.chunk);
+        }
+    }
+}
+
 std::optional<std::chrono::steady_clock::time_point> 
 DelayQueue::nextReleaseTime() const noexcept {
-    if (queue_.empty()) return std::nullopt;
-    return queue_.top().releaseTime;
+    const DelayedPacket* next = front();
+    if (!next) return std::nullopt;
+    return next->releaseTime;
 }
 
 void DelayQueue::clear() {
-    while (!queue_.empty()) {
-        queue_.pop();
+    fifoHead_ = 0;
+    fifoCount_ = 0;
+    for (uint32_t i = 0; i < chunks_.size(); ++i) {
+        releaseChunk(i);
     }
+    chunks_.clear();
+    tailChunk_ = NO_CHUNK;
+    spillTail_ = NO_CHUNK;
     totalBytes_ = 0;
+    memoryBytes_ = 0;
+}
+
+std::size_t DelayQueue::spillHeadroom() const noexcept {
+    if (spill_) return spill_->bytesFree();
+    return SpillStore::budget();  // Not spilled yet: the whole budget, or 0 if off
+}
+
+const DelayedPacket* DelayQueue::front() const noexcept {
+    return fifoCount_ ? &fifo_[fifoHead_] : nullptr;
+}
+
+DelayedPacket DelayQueue::popFront() {
+    DelayedPacket pkt = fifo_[fifoHead_];
+    fifoHead_ = (fifoHead_ + 1) & (fifo_.size() - 1);
+    --fifoCount_;
+    return pkt;
+}
+
+void DelayQueue::enqueue(const DelayedPacket& pkt) {
+    if (fifoCount_ == fifo_.size()) {
+        // Grow to the next power of two, unwrapping into the new ring
+        std::vector<DelayedPacket> grown(std::max<std::size_t>(fifo_.size() * 2, 16));
+        for (std::size_t i = 0; i < fifoCount_; ++i) {
+            grown[i] = fifo_[(fifoHead_ + i) & (fifo_.size() - 1)];
+        }
+        fifo_ = std::move(grown);
+        fifoHead_ = 0;
+    }
+
+    // Later bytes never leave before earlier ones: clamp to the tail's time
+    DelayedPacket& slot = fifo_[(fifoHead_ + fifoCount_) & (fifo_.size() - 1)];
+    slot = pkt;
+    if (slot.releaseTime < lastRelease_) {
+        slot.releaseTime = lastRelease_;
+    }
+    lastRelease_ = slot.releaseTime;
+    ++fifoCount_;
+}
+
+void DelayQueue::unaccount(const DelayedPacket& pkt) noexcept {
+    totalBytes_ -= pkt.length;
+    if (chunks_[pkt.chunk].segment == IN_MEMORY) {
+        memoryBytes_ -= pkt.length;
+    }
+}
+
+uint32_t DelayQueue::allocate(std::size_t length, bool spill, uint32_t& offset) {
+    uint32_t& tailIndex = spill ? spillTail_ : tailChunk_;
+    if (tailIndex != NO_CHUNK) {
+        Chunk& tail = chunks_[tailIndex];
+        if (tail.size - tail.used >= length) {
+            offset = tail.used;
+            tail.used += static_cast<uint32_t>(length);
+            ++tail.live;
+            return tailIndex;
+        }
+        // Retire the tail; it is freed when its last packet is released
+        if (tail.live == 0) {
+            releaseChunk(tailIndex);
+        }
+        tailIndex = NO_CHUNK;
+    }
+
+    uint32_t index = newChunk(length, spill);
+    if (index != NO_CHUNK) {
+        tailIndex = index;
+        offset = 0;
+    }
+    return index;
+}
+
+uint32_t DelayQueue::newChunk(std::size_t length, bool spill) {
+    Chunk chunk;
+    if (spill) {
+        if (!spill_) {
+            spill_ = SpillStore::local();
+            if (!spill_) return NO_CHUNK;  // Spilling not configured
+        }
+        auto segment = spill_->acquire();
+        if (!segment.data) return NO_CHUNK;
+        chunk.data = segment.data;
+        chunk.size = static_cast<uint32_t>(SpillStore::SEGMENT_SIZE);
+        chunk.segment = segment.index;
+    } else {
+        // Grow chunk size with the backlog so deep queues use few chunks
+        // while lightly delayed sessions only pin a small block
+        std::size_t want = std::max(length, std::min(memoryBytes_, BufferPool::SIZE_CLASSES.back()));
+        std::size_t actual = 0;
+        chunk.data = BufferPool::local().acquire(want, actual);
+        chunk.size = static_cast<uint32_t>(actual);
+    }
+    chunk.used = static_cast<uint32_t>(length);
+    chunk.live = 1;
+
+    uint32_t index = 0;
+    while (index < chunks_.size() && chunks_[index].data != nullptr) {
+        ++index;
+    }
+    if (index == chunks_.size()) {
+        chunks_.emplace_back();
+    }
+    chunks_[index] = chunk;
+    return index;
+}
+
+void DelayQueue::releaseChunk(uint32_t index) noexcept {
+    Chunk& chunk = chunks_[index];
+    if (!chunk.data) return;
+
+    if (chunk.segment != IN_MEMORY) {
+        spill_->release(SpillStore::Segment{chunk.data, chunk.segment});
+    } else {
+        BufferPool::local().release(chunk.data, chunk.size);
+    }
+    chunk = Chunk{};
+    if (index == tailChunk_) {
+        tailChunk_ = NO_CHUNK;
+    }
+    if (index == spillTail_) {
+        spillTail_ = NO_CHUNK;
+    }
 }
 
 void DelayQueue::dropOldest() {
-    if (queue_.empty()) return;
+    if (empty()) return;
     
-    // Priority queue orders by release time, so we drop the soonest (top)
+    // Packets pop by release time, so we drop the soonest (front)
     // This is the oldest in terms of when it was supposed to be sent
-    totalBytes_ -= queue_.top().payload.size();
-    queue_.pop();
+    DelayedPacket pkt = popFront();
+    unaccount(pkt);
+    release(pkt);
 }
 
 } // namespace shakyline
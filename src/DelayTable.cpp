@@ -0,0 +1,77 @@
+#include "shakyline/DelayTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace shakyline {
+
+namespace {
+
+constexpr double PARETO_ALPHA = 3.0;  // As netem's pareto table
+
+/// Standard normal quantile, by bisection on the CDF (table build only)
+double normalQuantile(double p) {
+    double lo = -10.0, hi = 10.0;
+    for (int i = 0; i < 100; ++i) {
+        double mid = 0.5 * (lo + hi);
+        if (0.5 * std::erfc(-mid / std::sqrt(2.0)) < p) lo = mid; else hi = mid;
+    }
+    return 0.5 * (lo + hi);
+}
+
+double paretoQuantile(double p) {
+    return std::pow(1.0 - p, -1.0 / PARETO_ALPHA);
+}
+
+double midpoint(std::size_t i, std::size_t n) {
+    return (static_cast<double>(i) + 0.5) / static_cast<double>(n);
+}
+
+} // namespace
+
+const DelayTable& DelayTable::get(DelayDistribution distribution) {
+    static const auto tables = [] {
+        std::array<DelayTable, 4> t;
+
+        for (std::size_t i = 0; i < SIZE; ++i) {
+            double p = midpoint(i, SIZE);
+            t[0].values_[i] = static_cast<float>(2.0 * p - 1.0);
+            t[1].values_[i] = static_cast<float>(normalQuantile(p));
+            t[2].values_[i] = static_cast<float>(paretoQuantile(p));
+        }
+        t[1].standardize();
+        t[2].standardize();
+
+        // Pareto-normal: quantiles of the sum of independent parts, from the
+        // full grid of GRID x GRID midpoint pairs (a discrete convolution)
+        constexpr std::size_t GRID = 512;
+        std::vector<double> normal(GRID), pareto(GRID), sum;
+        for (std::size_t i = 0; i < GRID; ++i) {
+            normal[i] = 0.25 * normalQuantile(midpoint(i, GRID));
+            pareto[i] = 0.75 * paretoQuantile(midpoint(i, GRID));
+        }
+        sum.reserve(GRID * GRID);
+        for (double n : normal) {
+            for (double p : pareto) sum.push_back(n + p);
+        }
+        std::sort(sum.begin(), sum.end());
+        for (std::size_t i = 0; i < SIZE; ++i) {
+            t[3].values_[i] = static_cast<float>(sum[(2 * i + 1) * sum.size() / (2 * SIZE)]);
+        }
+        t[3].standardize();
+        return t;
+    }();
+    return tables[static_cast<std::size_t>(distribution) % tables.size()];
+}
+
+void DelayTable::standardize() {
+    double mean = 0.0, squares = 0.0;
+    for (float v : values_) mean += v;
+    mean /= SIZE;
+    for (float v : values_) squares += (v - mean) * (v - mean);
+    double scale = 1.0 / std::sqrt(squares / SIZE);
+    for (float& v : values_) v = static_cast<float>((v - mean) * scale);
+}
+
+} // namespace shakyline
@@ -1,9 +1,18 @@
 #include "shakyline/EventLoop.hpp"
+#include "shakyline/Logger.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace shakyline {
 
 EventLoop::EventLoop()
-    : workGuard_(asio::make_work_guard(io_)) {}
+    : io_(1)  // Single-threaded loop: lets asio skip cross-thread wakeups
+    , workGuard_(asio::make_work_guard(io_)) {}
 
 EventLoop::~EventLoop() {
     stop();
@@ -16,11 +25,14 @@ void EventLoop::run() {
     running_.store(false);
 }
 
-void EventLoop::runInBackground() {
+void EventLoop::runInBackground(int cpu) {
     if (backgroundThread_.joinable()) {
         return;  // Already running
     }
-    backgroundThread_ = std::thread([this]() {
+    backgroundThread_ = std::thread([this, cpu]() {
+        if (cpu >= 0) {
+            pinCurrentThread(cpu);
+        }
         run();
     });
 }
@@ -36,4 +48,46 @@ void EventLoop::join() {
     }
 }
 
+void EventLoop::drain() {
+    io_.restart();
+    while (io_.poll() > 0) {
+    }
+}
+
+const char* EventLoop::backendName() noexcept {
+#if defined(SHAKYLINE_IO_URING)
+    return "io_uring";
+#elif defined(__linux__)
+    return "epoll";
+#else
+    return "default";
+#endif
+}
+
+bool EventLoop::ioUringSupported() noexcept {
+#if defined(__linux__) && defined(__NR_io_uring_setup)
+    // Minimal ring: 1 entry, zeroed params. Kernel fills the params on success.
+    unsigned char params[120] = {};
+    long fd = ::syscall(__NR_io_uring_setup, 1, params);
+    if (fd < 0) return false;
+    ::close(static_cast<int>(fd));
+    return true;
+#else
+    return false;
+#endif
+}
+
+void EventLoop::pinCurrentThread(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        globalLogger().warn(0, 0, "cpu_pin_failed", "", "cpu=" + std::to_string(cpu));
+    }
+#else
+    (void)cpu;  // Affinity is best-effort; not supported on this platform
+#endif
+}
+
 } // namespace shakyline
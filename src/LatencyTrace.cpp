@@ -0,0 +1,241 @@
+#include "shakyline/LatencyTrace.hpp"
+#include "shakyline/Config.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#endif
+
+namespace shakyline {
+
+namespace {
+
+constexpr char MAGIC[8] = {'S', 'K', 'L', 'T', 'R', 'A', 'C', 'E'};
+constexpr uint32_t FORMAT_VERSION = 1;
+constexpr uint32_t MAX_SAMPLE_US = ConfigLimits::MAX_LATENCY_MS * 1000;
+
+/// On-disk and in-memory layout: header, then SIZE uint32 quantiles
+struct TraceHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t bits;
+    uint64_t samples;
+};
+
+constexpr std::size_t MAPPING_SIZE = sizeof(TraceHeader) + LatencyTrace::SIZE * sizeof(uint32_t);
+constexpr std::size_t IMAGE_WORDS = MAPPING_SIZE / sizeof(uint64_t);  // Header-aligned
+
+std::vector<uint32_t> parseSamples(std::string_view text) {
+    std::vector<uint32_t> samples;
+    samples.reserve(text.size() / 8);
+
+    const char* p = text.data();
+    const char* end = p + text.size();
+    for (;;) {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t' || *p == ',')) ++p;
+        if (p == end) break;
+
+        double value;
+        auto [next, ec] = std::from_chars(p, end, value);
+        if (ec != std::errc() || !(value >= 0.0)) {
+            throw std::invalid_argument("bad latency sample at byte " +
+                                        std::to_string(p - text.data()));
+        }
+        samples.push_back(static_cast<uint32_t>(
+            std::min(std::llround(value), static_cast<long long>(MAX_SAMPLE_US))));
+        p = next;
+    }
+    if (samples.empty()) {
+        throw std::invalid_argument("no latency samples");
+    }
+    return samples;
+}
+
+/// LSD radix sort, two 16-bit digits: linear, so 10M samples sort in tens of ms
+void radixSort(std::vector<uint32_t>& values) {
+    std::vector<uint32_t> scratch(values.size());
+    for (unsigned shift : {0u, 16u}) {
+        std::vector<std::size_t> offsets(65537, 0);
+        for (uint32_t v : values) ++offsets[((v >> shift) & 0xffff) + 1];
+        for (std::size_t i = 1; i < offsets.size(); ++i) offsets[i] += offsets[i - 1];
+        for (uint32_t v : values) scratch[offsets[(v >> shift) & 0xffff]++] = v;
+        values.swap(scratch);
+    }
+}
+
+void fillMapping(void* mapping, const std::vector<uint32_t>& sorted) {
+    auto* header = static_cast<TraceHeader*>(mapping);
+    std::memcpy(header->magic, MAGIC, sizeof(MAGIC));
+    header->version = FORMAT_VERSION;
+    header->bits = LatencyTrace::BITS;
+    header->samples = sorted.size();
+
+    auto* table = reinterpret_cast<uint32_t*>(header + 1);
+    uint64_t n = sorted.size();
+    for (std::size_t i = 0; i < LatencyTrace::SIZE; ++i) {
+        table[i] = sorted[(2 * i + 1) * n / (2 * LatencyTrace::SIZE)];
+    }
+}
+
+std::runtime_error ioError(const std::string& what, const std::string& path) {
+    return std::runtime_error(what + " " + path + ": " + std::strerror(errno));
+}
+
+bool validHeader(const void* image) noexcept {
+    const auto* header = static_cast<const TraceHeader*>(image);
+    return std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0 &&
+           header->version == FORMAT_VERSION && header->bits == LatencyTrace::BITS;
+}
+
+} // namespace
+
+LatencyTrace::LatencyTrace(void* mapping, std::size_t size) noexcept
+    : image_(mapping)
+    , mappingSize_(size)
+    , table_(reinterpret_cast<const uint32_t*>(static_cast<const TraceHeader*>(mapping) + 1)) {}
+
+LatencyTrace::LatencyTrace(std::unique_ptr<uint64_t[]> image) noexcept
+    : image_(image.get())
+    , heap_(std::move(image))
+    , table_(reinterpret_cast<const uint32_t*>(static_cast<const TraceHeader*>(image_) + 1)) {}
+
+LatencyTrace::~LatencyTrace() {
+#ifdef __linux__
+    if (mappingSize_ > 0) {
+        ::munmap(const_cast<void*>(image_), mappingSize_);
+    }
+#endif
+}
+
+uint64_t LatencyTrace::sampleCount() const noexcept {
+    return static_cast<const TraceHeader*>(image_)->samples;
+}
+
+#ifdef __linux__
+
+std::shared_ptr<const LatencyTrace> LatencyTrace::build(std::string_view samples,
+                                                        const std::string& path) {
+    std::vector<uint32_t> sorted = parseSamples(samples);
+    radixSort(sorted);
+
+    if (path.empty()) {
+        void* mapping = ::mmap(nullptr, MAPPING_SIZE, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throw ioError("cannot map", "trace");
+        }
+        fillMapping(mapping, sorted);
+        ::mprotect(mapping, MAPPING_SIZE, PROT_READ);
+        return std::shared_ptr<const LatencyTrace>(new LatencyTrace(mapping, MAPPING_SIZE));
+    }
+
+    // Written to a unique file beside the target and renamed over it: a
+    // concurrent open() sees the old trace or the new one, never a partial
+    // file, and concurrent uploads of one name never share a temp file
+    std::vector<uint64_t> image(IMAGE_WORDS);
+    fillMapping(image.data(), sorted);
+
+    std::string temp = path + ".XXXXXX";
+    int fd = ::mkstemp(temp.data());
+    if (fd < 0) {
+        throw ioError("cannot create", temp);
+    }
+    bool written = ::fchmod(fd, 0644) == 0 &&
+                   ::write(fd, image.data(), MAPPING_SIZE) == static_cast<ssize_t>(MAPPING_SIZE);
+    ::close(fd);
+    if (!written || ::rename(temp.c_str(), path.c_str()) != 0) {
+        ::unlink(temp.c_str());
+        throw ioError("cannot write", path);
+    }
+    return open(path);
+}
+
+std::shared_ptr<const LatencyTrace> LatencyTrace::open(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw ioError("cannot open", path);
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) != MAPPING_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("not a trace file: " + path);
+    }
+    void* mapping = ::mmap(nullptr, MAPPING_SIZE, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);  // The mapping keeps the file
+    if (mapping == MAP_FAILED) {
+        throw ioError("cannot map", path);
+    }
+
+    auto trace = std::shared_ptr<const LatencyTrace>(new LatencyTrace(mapping, MAPPING_SIZE));
+    if (!validHeader(mapping)) {
+        throw std::runtime_error("not a trace file: " + path);
+    }
+    return trace;
+}
+
+#else
+
+std::shared_ptr<const LatencyTrace> LatencyTrace::build(std::string_view samples,
+                                                        const std::string& path) {
+    std::vector<uint32_t> sorted = parseSamples(samples);
+    radixSort(sorted);
+
+    auto image = std::make_unique<uint64_t[]>(IMAGE_WORDS);
+    fillMapping(image.get(), sorted);
+
+    if (!path.empty()) {
+        // Unique per upload, then renamed over the target (see above)
+        static std::atomic<uint64_t> uploads{0};
+        std::string temp = path + ".tmp" + std::to_string(uploads.fetch_add(1));
+        bool written;
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            out.write(reinterpret_cast<const char*>(image.get()), MAPPING_SIZE);
+            written = static_cast<bool>(out.flush());
+        }
+        std::error_code ec;
+        if (written) {
+            std::filesystem::rename(temp, path, ec);
+        }
+        if (!written || ec) {
+            std::filesystem::remove(temp, ec);
+            throw std::runtime_error("cannot write " + path);
+        }
+    }
+    return std::shared_ptr<const LatencyTrace>(new LatencyTrace(std::move(image)));
+}
+
+std::shared_ptr<const LatencyTrace> LatencyTrace::open(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in) {
+        throw ioError("cannot open", path);
+    }
+    if (static_cast<std::size_t>(in.tellg()) != MAPPING_SIZE) {
+        throw std::runtime_error("not a trace file: " + path);
+    }
+
+    auto image = std::make_unique<uint64_t[]>(IMAGE_WORDS);
+    in.seekg(0);
+    if (!in.read(reinterpret_cast<char*>(image.get()), MAPPING_SIZE) || !validHeader(image.get())) {
+        throw std::runtime_error("not a trace file: " + path);
+    }
+    return std::shared_ptr<const LatencyTrace>(new LatencyTrace(std::move(image)));
+}
+
+#endif
+
+} // namespace shakyline
@@ -41,6 +41,11 @@ MetricsRegistry::MetricsRegistry() {
         "latency_injected_ms",
         std::vector<uint64_t>{10, 50, 100, 500, 1000, 5000, 30000}
     );
+
+    latencyUsHist_ = std::make_unique<Histogram>(
+        "latency_injected_us",
+        std::vector<uint64_t>{50, 100, 250, 500, 1000, 2500, 10000, 100000}
+    );
     
     lifetimeHist_ = std::make_unique<Histogram>(
         "session_lifetime_seconds",
@@ -53,8 +58,9 @@ MetricsRegistry::MetricsRegistry() {
     );
 }
 
-void MetricsRegistry::observeLatencyInjected(uint64_t ms) {
-    latencyHist_->observe(ms);
+void MetricsRegistry::observeLatencyInjected(uint64_t us) {
+    latencyHist_->observe((us + 999) / 1000);  // Rounded up: no delay reads as 0 ms
+    latencyUsHist_->observe(us);
 }
 
 void MetricsRegistry::observeSessionLifetime(uint64_t seconds) {
@@ -88,6 +94,10 @@ std::string MetricsRegistry::renderPrometheus() const {
     oss << "# TYPE shakyline_packets_delayed_total counter\n";
     oss << "shakyline_packets_delayed_total " << packetsDelayed_.load() << "\n\n";
     
+    oss << "# HELP shakyline_packets_reordered_total Total packets held back for reordering\n";
+    oss << "# TYPE shakyline_packets_reordered_total counter\n";
+    oss << "shakyline_packets_reordered_total " << packetsReordered_.load() << "\n\n";
+    
     oss << "# HELP shakyline_stall_events_total Total stall events\n";
     oss << "# TYPE shakyline_stall_events_total counter\n";
     oss << "shakyline_stall_events_total " << stallEvents_.load() << "\n\n";
@@ -103,6 +113,10 @@ std::string MetricsRegistry::renderPrometheus() const {
     oss << "# HELP shakyline Latency injection histogram\n";
     oss << "# TYPE shakyline_latency_injected_ms histogram\n";
     oss << latencyHist_->renderPrometheus("shakyline") << "\n";
+
+    oss << "# HELP shakyline Latency injection histogram (microseconds)\n";
+    oss << "# TYPE shakyline_latency_injected_us histogram\n";
+    oss << latencyUsHist_->renderPrometheus("shakyline") << "\n";
     
     oss << "# HELP shakyline Session lifetime histogram\n";
     oss << "# TYPE shakyline_session_lifetime_seconds histogram\n";
@@ -27,6 +27,15 @@ void ProxyServer::start() {
 
     acceptor_.open(endpoint.protocol());
     acceptor_.set_option(asio::socket_base::reuse_address(true));
+    if (config_.ioThreads > 1 && config_.acceptMode == AcceptMode::ReusePort) {
+        // Every shard binds the same port; the kernel hashes connections across them
+#ifdef SO_REUSEPORT
+        using reuse_port = asio::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+        acceptor_.set_option(reuse_port(true));
+#else
+        throw std::runtime_error("--threads > 1 requires SO_REUSEPORT support");
+#endif
+    }
     acceptor_.bind(endpoint);
     acceptor_.listen(asio::socket_base::max_listen_connections);
 
@@ -90,6 +99,12 @@ void ProxyServer::onAccept(const asio::error_code& ec, asio::ip::tcp::socket soc
 
     globalLogger().debug(0, 0, "connection_accepted", "", "from=" + remoteAddr);
 
+    if (!handoffTargets_.empty()) {
+        handOff(std::move(socket), remoteAddr);
+        doAccept();
+        return;
+    }
+
     // Create session
     Socket clientSocket(std::move(socket));
     auto session = sessionManager_->createSession(std::move(clientSocket));
@@ -102,4 +117,38 @@ void ProxyServer::onAccept(const asio::error_code& ec, asio::ip::tcp::socket soc
     doAccept();
 }
 
+void ProxyServer::handOff(asio::ip::tcp::socket socket, const std::string& remoteAddr) {
+    // Pick the shard with the lowest combined sessions/queued bytes/loop lag
+    const SessionManager::Ptr* target = &handoffTargets_.front();
+    uint64_t bestScore = (*target)->loadScore();
+    for (const auto& candidate : handoffTargets_) {
+        uint64_t score = candidate->loadScore();
+        if (score < bestScore) {
+            bestScore = score;
+            target = &candidate;
+        }
+    }
+
+    if (*target == sessionManager_) {
+        if (!sessionManager_->createSession(Socket(std::move(socket)))) {
+            globalLogger().warn(0, 0, "session_rejected", "", "from=" + remoteAddr);
+        }
+        return;
+    }
+
+    // Detach from this loop's reactor and re-register on the target loop
+    asio::error_code ec;
+    auto protocol = socket.local_endpoint(ec).protocol();
+    if (ec) return;  // Peer already gone
+    auto fd = socket.release(ec);
+    if (ec) {
+        globalLogger().warn(0, 0, "handoff_failed", "", "error=" + ec.message());
+        return;
+    }
+
+    globalLogger().debug(0, 0, "connection_handoff", "", 
+                         "from=" + remoteAddr + " score=" + std::to_string(bestScore));
+    (*target)->adoptSocket(protocol, fd);
+}
+
 } // namespace shakyline
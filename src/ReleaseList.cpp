@@ -0,0 +1,81 @@
+#include "shakyline/ReleaseList.hpp"
+
+#include <algorithm>
+
+namespace shakyline {
+
+void ReleaseList::push(const DelayedPacket& pkt, const Buffer& buf) {
+    if (empty()) {
+        // Everything buffered now was committed before this packet came due
+        packets_.clear();
+        head_ = 0;
+        frontOffset_ = 0;
+        aheadBytes_ = buf.readable();
+    }
+    packets_.push_back(pkt);
+    bytes_ += pkt.length;
+}
+
+std::span<const asio::const_buffer> ReleaseList::gather(Buffer& buf, const DelayQueue& queue,
+                                                        std::size_t limit) {
+    gather_.clear();
+
+    std::size_t ahead = empty() ? buf.readable() : aheadBytes_;
+    if (ahead > 0) {
+        for (const auto& segment : buf.dataToSend()) {
+            std::size_t n = std::min({segment.size(), ahead, limit});
+            if (n == 0) break;
+            gather_.emplace_back(segment.data(), n);
+            ahead -= n;
+            limit -= n;
+        }
+    }
+
+    // Packets only once every Buffer byte ahead of them is in this write
+    if (ahead == 0) {
+        std::size_t skip = frontOffset_;
+        for (std::size_t i = head_; i < packets_.size() && limit > 0; ++i) {
+            if (gather_.size() == MAX_GATHER) break;
+            auto payload = queue.payload(packets_[i]).subspan(skip);
+            std::size_t n = std::min(payload.size(), limit);
+            gather_.emplace_back(payload.data(), n);
+            limit -= n;
+            skip = 0;
+        }
+    }
+    return gather_;
+}
+
+void ReleaseList::consume(std::size_t written, Buffer& buf, DelayQueue& queue) noexcept {
+    std::size_t ahead = empty() ? buf.readable() : aheadBytes_;
+    std::size_t fromBuffer = std::min(written, ahead);
+    if (fromBuffer > 0) {
+        buf.consume(fromBuffer);
+        aheadBytes_ -= std::min(aheadBytes_, fromBuffer);
+        written -= fromBuffer;
+    }
+
+    while (written > 0 && !empty()) {
+        const DelayedPacket& pkt = packets_[head_];
+        std::size_t remaining = pkt.length - frontOffset_;
+        if (written < remaining) {
+            frontOffset_ += written;
+            bytes_ -= written;
+            return;
+        }
+        written -= remaining;
+        bytes_ -= remaining;
+        frontOffset_ = 0;
+        queue.release(pkt);
+        ++head_;
+    }
+
+    // A list that never fully drains (throttle plus delay) would otherwise
+    // grow without bound; dropping the sent prefix keeps it amortized O(1)
+    if (head_ > packets_.size() / 2) {
+        packets_.erase(packets_.begin(), packets_.begin() + static_cast<std::ptrdiff_t>(head_));
+        head_ = 0;
+    }
+}
+
+} // namespace shakyline
@@ -0,0 +1,152 @@
+#include "shakyline/ReleaseScheduler.hpp"
+#include "shakyline/Session.hpp"
+
+#include <algorithm>
+#include <functional>
+
+#ifdef __linux__
+#include <sys/prctl.h>
+#endif
+
+namespace shakyline {
+
+ReleaseScheduler::ReleaseScheduler(asio::io_context& io)
+    : timer_(io) {}
+
+ReleaseScheduler::~ReleaseScheduler() {
+    timer_.cancel();
+}
+
+ReleaseScheduler::Handle ReleaseScheduler::attach(Session& session) {
+    uint32_t slot;
+    if (!freeSlots_.empty()) {
+        slot = freeSlots_.back();
+        freeSlots_.pop_back();
+    } else {
+        slot = static_cast<uint32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    slots_[slot].session = &session;
+    return {slot, slots_[slot].generation};
+}
+
+void ReleaseScheduler::detach(Handle handle) noexcept {
+    Slot& slot = slots_[handle.slot];
+    if (slot.generation != handle.generation) return;
+
+    stale_ += slot.pending;
+    slot.pending = 0;
+    slot.session = nullptr;
+    ++slot.generation;
+    try {
+        freeSlots_.push_back(handle.slot);
+    } catch (...) {
+        // Slot is leaked from reuse only
+    }
+
+    if (stale_ >= COMPACT_MIN && stale_ * 2 > heap_.size()) {
+        dropStale();
+    }
+}
+
+void ReleaseScheduler::request(Clock::time_point when, Handle handle, bool precise) {
+    Entry entry{when, handle.slot, handle.generation, precise};
+    Clock::time_point wake = entry.wakeAt();
+    heap_.push_back(entry);
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+    ++slots_[handle.slot].pending;
+    if (precise) ++precise_;
+
+    // onTimer re-arms once after the batch; otherwise only an earlier
+    // wakeup needs the timer moved
+    if (!firing_ && wake < armedAt_) {
+        arm();
+    }
+}
+
+void ReleaseScheduler::arm() {
+    setTightSlack(precise_ > 0);
+    if (heap_.empty()) {
+        armedAt_ = Clock::time_point::max();
+        timer_.cancel();
+        return;
+    }
+
+    armedAt_ = heap_.front().wakeAt();
+    timer_.expires_at(armedAt_);
+    timer_.async_wait([this](const asio::error_code& ec) { onTimer(ec); });
+}
+
+void ReleaseScheduler::onTimer(const asio::error_code& ec) {
+    if (ec == asio::error::operation_aborted) return;
+
+    spinUntilDue();
+
+    // Collect everything due first so sessions can re-register while flushing
+    auto now = Clock::now();
+    while (!heap_.empty() && heap_.front().when <= now) {
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+        const Entry& entry = heap_.back();
+        if (entry.precise) --precise_;
+        Slot& slot = slots_[entry.slot];
+        if (slot.generation == entry.generation) {
+            --slot.pending;
+            batch_.push_back(entry);
+        } else {
+            --stale_;
+        }
+        heap_.pop_back();
+    }
+
+    firing_ = true;
+    for (const auto& entry : batch_) {
+        // Checked again: an earlier callback in the batch may have closed it
+        const Slot& slot = slots_[entry.slot];
+        if (slot.generation != entry.generation) continue;
+        // Held for the call, as a flush may drop the session's last owner
+        auto session = slot.session->shared_from_this();
+        session->onReleaseDue(entry.when);
+    }
+    batch_.clear();
+    firing_ = false;
+
+    arm();
+}
+
+void ReleaseScheduler::dropStale() {
+    // Only ever removes entries: the armed wakeup stays early enough
+    std::erase_if(heap_, [this](const Entry& entry) {
+        return slots_[entry.slot].generation != entry.generation;
+    });
+    std::make_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+    stale_ = 0;
+    precise_ = static_cast<std::size_t>(
+        std::count_if(heap_.begin(), heap_.end(), [](const Entry& entry) { return entry.precise; }));
+}
+
+void ReleaseScheduler::setTightSlack(bool tight) noexcept {
+    if (tight == tightSlack_) return;
+    tightSlack_ = tight;
+#ifdef __linux__
+    // The default 50µs slack would swamp microsecond profiles; 0 restores it
+    ::prctl(PR_SET_TIMERSLACK, tight ? 1UL : 0UL, 0, 0, 0);
+#endif
+}
+
+void ReleaseScheduler::spinUntilDue() {
+    if (heap_.empty()) return;
+
+    // Woken early for a precise entry: busy-wait out the remaining few µs
+    // rather than sleep again and pay another wakeup's latency
+    const Entry& next = heap_.front();
+    if (!next.precise) return;
+    auto now = Clock::now();
+    if (next.when <= now || next.when - now > SPIN_WINDOW) return;
+    while (Clock::now() < next.when) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    }
+}
+
+} // namespace shakyline
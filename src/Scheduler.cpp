@@ -1,62 +1,224 @@
 #include "shakyline/Scheduler.hpp"
 
+#include <algorithm>
+
 namespace shakyline {
 
 Scheduler::Scheduler(asio::io_context& io)
-    : io_(io) {}
-
-Scheduler::TimerId Scheduler::schedule(std::chrono::milliseconds delay, Callback cb) {
-    TimerId id = nextId_.fetch_add(1);
-    
-    auto timer = std::make_unique<asio::steady_timer>(io_);
-    timer->expires_after(delay);
-    
-    asio::steady_timer* timerPtr = timer.get();
-    
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        timers_[id] = std::move(timer);
-    }
-    
-    timerPtr->async_wait([this, id, cb = std::move(cb)](const asio::error_code& ec) {
-        // Remove timer from map
-        {
-            std::lock_guard<std::mutex> lock(mutex_);
-            timers_.erase(id);
-        }
-        
-        // Only execute if not cancelled
-        if (ec != asio::error::operation_aborted) {
-            cb();
-        }
-    });
-    
-    return id;
+    : timer_(io)
+    , epoch_(Clock::now()) {
+    buckets_.fill(NIL);
+}
+
+Scheduler::~Scheduler() {
+    cancelAll();
+}
+
+Scheduler::TimerId Scheduler::arm(uint32_t index, std::chrono::milliseconds delay) {
+    // Idle wheel: jump straight to now instead of replaying empty ticks
+    if (activeCount_ == 0) {
+        currentTick_ = std::max(currentTick_, nowTick());
+    }
+
+    TimerNode& node = nodes_[index];
+    uint64_t ticks = delay.count() > 0 ? static_cast<uint64_t>(delay.count()) : 0;
+    node.expiry = nowTick() + ticks;
+    link(index);
+    ++activeCount_;
+
+    if (!advancing_ && node.expiry < armedTick_) {
+        rearm();
+    }
+    return (static_cast<TimerId>(node.generation) << 32) | index;
 }
 
 bool Scheduler::cancel(TimerId id) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = timers_.find(id);
-    if (it == timers_.end()) {
-        return false;
-    }
-    
-    it->second->cancel();
-    timers_.erase(it);
+    uint32_t index = static_cast<uint32_t>(id & 0xffffffffu);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (index >= nodes_.size()) return false;
+
+    TimerNode& node = nodes_[index];
+    if (node.generation != generation || node.bucket >= NO_BUCKET) {
+        return false;  // Already fired, cancelled, recycled or running
+    }
+
+    unlink(index);
+    --activeCount_;
+    freeNode(index);
+    // The asio timer may fire early with nothing due; rearm() handles it
     return true;
 }
 
 void Scheduler::cancelAll() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    for (auto& [id, timer] : timers_) {
-        timer->cancel();
+    for (uint32_t i = 0; i < nodes_.size(); ++i) {
+        if (nodes_[i].bucket < NO_BUCKET) {
+            unlink(i);
+            freeNode(i);
+        }
     }
-    timers_.clear();
+    activeCount_ = 0;
+    armedTick_ = UINT64_MAX;
+    timer_.cancel();
 }
 
-std::size_t Scheduler::activeCount() const {
-    std::lock_guard<std::mutex> lock(const_cast<std::mutex&>(mutex_));
-    return timers_.size();
+uint32_t Scheduler::allocateNode() {
+    if (freeHead_ != NIL) {
+        uint32_t index = freeHead_;
+        freeHead_ = nodes_[index].next;
+        nodes_[index].next = NIL;
+        return index;
+    }
+    nodes_.emplace_back();
+    return static_cast<uint32_t>(nodes_.size() - 1);
+}
+
+void Scheduler::freeNode(uint32_t index) noexcept {
+    TimerNode& node = nodes_[index];
+    if (node.destroy) {
+        node.destroy(node.storage);
+    }
+    node.invoke = nullptr;
+    node.destroy = nullptr;
+    node.bucket = NO_BUCKET;
+    node.prev = NIL;
+    ++node.generation;
+    if (node.generation == 0) node.generation = 1;  // Keep IDs non-zero
+    node.next = freeHead_;
+    freeHead_ = index;
+}
+
+void Scheduler::link(uint32_t index) {
+    uint64_t expiry = nodes_[index].expiry;
+    uint64_t span = expiry > currentTick_ ? expiry - currentTick_ : 0;
+    if (span > MAX_SPAN) {
+        span = MAX_SPAN;  // Parked in the top level; re-cascades with real expiry
+    }
+    uint64_t slotTick = currentTick_ + span;
+
+    std::size_t level = 0;
+    while (level + 1 < LEVELS && span >= (uint64_t(1) << (SLOT_BITS * (level + 1)))) {
+        ++level;
+    }
+    std::size_t slot = (slotTick >> (SLOT_BITS * level)) & SLOT_MASK;
+    pushBucket(static_cast<uint16_t>(level * SLOTS + slot), index);
+}
+
+void Scheduler::pushBucket(uint16_t bucket, uint32_t index) noexcept {
+    TimerNode& node = nodes_[index];
+    uint32_t& first = head(bucket);
+    node.bucket = bucket;
+    node.prev = NIL;
+    node.next = first;
+    if (first != NIL) {
+        nodes_[first].prev = index;
+    }
+    first = index;
+}
+
+void Scheduler::unlink(uint32_t index) noexcept {
+    TimerNode& node = nodes_[index];
+    if (node.prev != NIL) {
+        nodes_[node.prev].next = node.next;
+    } else {
+        head(node.bucket) = node.next;
+    }
+    if (node.next != NIL) {
+        nodes_[node.next].prev = node.prev;
+    }
+    node.next = NIL;
+    node.prev = NIL;
+}
+
+uint32_t& Scheduler::head(uint16_t bucket) noexcept {
+    return bucket == WORK_BUCKET ? workHead_ : buckets_[bucket];
+}
+
+uint64_t Scheduler::nowTick() const noexcept {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        Clock::now() - epoch_).count());
+}
+
+void Scheduler::advance(uint64_t targetTick) {
+    while (currentTick_ <= targetTick && activeCount_ > 0) {
+        // On each level wrap, redistribute the next coarser slot downwards
+        for (std::size_t level = 1; level < LEVELS; ++level) {
+            if ((currentTick_ & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) != 0) break;
+            cascade(level);
+        }
+
+        // Move this tick's slot to the work list, then fire one node at a time
+        // so callbacks may freely schedule or cancel (including work-list peers)
+        uint16_t bucket = static_cast<uint16_t>(currentTick_ & SLOT_MASK);
+        while (buckets_[bucket] != NIL) {
+            uint32_t index = buckets_[bucket];
+            unlink(index);
+            pushBucket(WORK_BUCKET, index);
+        }
+        ++currentTick_;
+
+        while (workHead_ != NIL) {
+            uint32_t index = workHead_;
+            unlink(index);
+            --activeCount_;
+            TimerNode& node = nodes_[index];
+            node.bucket = RUNNING;  // Callback may cancel its own id; ignore it
+            node.invoke(node.storage);
+            freeNode(index);
+        }
+    }
+
+    if (activeCount_ == 0) {
+        currentTick_ = targetTick + 1;
+    }
+}
+
+void Scheduler::cascade(std::size_t level) {
+    std::size_t slot = (currentTick_ >> (SLOT_BITS * level)) & SLOT_MASK;
+    uint16_t bucket = static_cast<uint16_t>(level * SLOTS + slot);
+    while (buckets_[bucket] != NIL) {
+        uint32_t index = buckets_[bucket];
+        unlink(index);
+        link(index);
+    }
+}
+
+void Scheduler::rearm() {
+    if (activeCount_ == 0) {
+        armedTick_ = UINT64_MAX;
+        timer_.cancel();
+        return;
+    }
+
+    // Earliest of: next occupied level-0 slot, or the cascade point of the
+    // next occupied slot on a coarser level. Far-off timers cost no wakeups.
+    uint64_t target = UINT64_MAX;
+    for (std::size_t level = 0; level < LEVELS; ++level) {
+        unsigned shift = SLOT_BITS * static_cast<unsigned>(level);
+        uint64_t first = (currentTick_ + (uint64_t(1) << shift) - 1) >> shift;
+        if ((first << shift) >= target) break;
+
+        for (uint64_t i = first; i < first + SLOTS; ++i) {
+            if ((i << shift) >= target) break;
+            if (buckets_[level * SLOTS + (i & SLOT_MASK)] != NIL) {
+                target = i << shift;
+                break;
+            }
+        }
+    }
+
+    armedTick_ = target;
+    timer_.expires_at(epoch_ + std::chrono::milliseconds(target));
+    timer_.async_wait([this](const asio::error_code& ec) { onTick(ec); });
+}
+
+void Scheduler::onTick(const asio::error_code& ec) {
+    if (ec == asio::error::operation_aborted) return;
+
+    armedTick_ = UINT64_MAX;
+    advancing_ = true;
+    advance(nowTick());
+    advancing_ = false;
+    rearm();
 }
 
 } // namespace shakyline
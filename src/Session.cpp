@@ -10,33 +10,39 @@ Session::Ptr Session::create(
     Socket clientSocket,
     std::weak_ptr<SessionManager> manager,
     Scheduler& scheduler,
+    ReleaseScheduler& releaser,
     const AnomalyEngine& engine,
     ConfigManager& config,
     uint64_t sessionId
 ) {
-    // Can't use make_shared with private constructor
-    return Ptr(new Session(io, std::move(clientSocket), std::move(manager),
-                           scheduler, engine, config, sessionId));
+    // One allocation for session + control block, recycled per loop thread
+    return std::allocate_shared<Session>(
+        FreeListAllocator<Session>(), PrivateTag(), io, std::move(clientSocket),
+        std::move(manager), scheduler, releaser, engine, config, sessionId);
 }
 
 Session::Session(
+    PrivateTag,
     asio::io_context& io,
     Socket clientSocket,
     std::weak_ptr<SessionManager> manager,
     Scheduler& scheduler,
+    ReleaseScheduler& releaser,
     const AnomalyEngine& engine,
     ConfigManager& config,
     uint64_t sessionId
-) : strand_(asio::make_strand(io))
+) : executor_(io.get_executor())
   , clientSocket_(std::move(clientSocket))
   , serverSocket_(Socket::create(io))
   , manager_(std::move(manager))
   , scheduler_(scheduler)
+  , releaser_(releaser)
   , engine_(engine)
   , config_(config)
   , sessionId_(sessionId)
   , startTime_(std::chrono::steady_clock::now())
   , lastActivity_(startTime_)
+  , releaseHandle_(releaser.attach(*this))
 {
     globalLogger().info(sessionId_, 0, "session_created");
     globalMetrics().incrementActiveSessions();
@@ -46,8 +52,13 @@ Session::~Session() {
     // Cancel any pending timers
     if (connectTimerId_) scheduler_.cancel(connectTimerId_);
     if (idleTimerId_) scheduler_.cancel(idleTimerId_);
-    if (stallTimerId_) scheduler_.cancel(stallTimerId_);
-    if (delayTimerId_) scheduler_.cancel(delayTimerId_);
+    if (clientStallTimerId_) scheduler_.cancel(clientStallTimerId_);
+    if (serverStallTimerId_) scheduler_.cancel(serverStallTimerId_);
+    if (clientPaceTimerId_) scheduler_.cancel(clientPaceTimerId_);
+    if (serverPaceTimerId_) scheduler_.cancel(serverPaceTimerId_);
+    if (c2sReorder_.timerId) scheduler_.cancel(c2sReorder_.timerId);
+    if (s2cReorder_.timerId) scheduler_.cancel(s2cReorder_.timerId);
+    releaser_.detach(releaseHandle_);
 
     auto lifetime = std::chrono::duration_cast<std::chrono::seconds>(
         std::chrono::steady_clock::now() - startTime_
@@ -61,8 +72,7 @@ Session::~Session() {
 
 void Session::start(const asio::ip::tcp::endpoint& upstream) {
     // Fetch current profile
-    currentProfile_ = config_.getProfile("default");
-    profileVersion_ = currentProfile_.version;
+    refreshProfile();
 
     // Set connect timeout
     connectTimerId_ = scheduler_.scheduleGuarded(
@@ -79,11 +89,9 @@ void Session::start(const asio::ip::tcp::endpoint& upstream) {
 
     // Start upstream connection
     serverSocket_.asyncConnect(upstream,
-        asio::bind_executor(strand_, 
-            [self = shared_from_this()](const asio::error_code& ec) {
-                self->onConnectComplete(ec);
-            }
-        )
+        [self = shared_from_this()](const asio::error_code& ec) {
+            self->onConnectComplete(ec);
+        }
     );
 }
 
@@ -106,12 +114,15 @@ void Session::onConnectComplete(const asio::error_code& ec) {
     upstreamState_ = UpstreamState::Connected;
     globalLogger().info(sessionId_, 0, "upstream_connected");
 
-    // Configure sockets
+    // Configure sockets (non-blocking so splice never stalls the loop)
     clientSocket_.setNoDelay(true);
     serverSocket_.setNoDelay(true);
+    clientSocket_.setNonBlocking(true);
+    serverSocket_.setNonBlocking(true);
 
-    // Start idle timer
-    resetIdleTimer();
+    // Start idle timer (activity only stamps lastActivity_; the timer
+    // re-checks the real deadline when it fires)
+    armIdleTimer(config_.serverConfig().idleTimeout);
 
     // Start reading from both ends
     startClientRead();
@@ -121,33 +132,62 @@ void Session::onConnectComplete(const asio::error_code& ec) {
 void Session::startClientRead() {
     if (!channels_.clientReadOpen || clientReadPaused_) return;
 
-    clientSocket_.asyncRead(
-        asio::buffer(clientReadBuf_),
-        asio::bind_executor(strand_,
-            [self = shared_from_this()](const asio::error_code& ec, std::size_t n) {
-                self->onClientRead(ec, n);
-            }
-        )
+    refreshProfile();
+    if (canSplice(Direction::ClientToServer)) {
+        startClientSplice();
+        return;
+    }
+
+    // Wait for readiness, then read straight into the outbound buffer.
+    // Nothing is reserved while waiting, so delay flushes can still append.
+    clientSocket_.asyncWaitReadable(
+        makeAllocHandler(clientReadMem_,
+            [self = shared_from_this()](const asio::error_code& ec) {
+                self->onClientRead(ec);
+            })
     );
 }
 
 void Session::startServerRead() {
     if (!channels_.serverReadOpen || serverReadPaused_) return;
 
-    serverSocket_.asyncRead(
-        asio::buffer(serverReadBuf_),
-        asio::bind_executor(strand_,
-            [self = shared_from_this()](const asio::error_code& ec, std::size_t n) {
-                self->onServerRead(ec, n);
-            }
-        )
+    refreshProfile();
+    if (canSplice(Direction::ServerToClient)) {
+        startServerSplice();
+        return;
+    }
+
+    // Wait for readiness, then read straight into the outbound buffer.
+    // Nothing is reserved while waiting, so delay flushes can still append.
+    serverSocket_.asyncWaitReadable(
+        makeAllocHandler(serverReadMem_,
+            [self = shared_from_this()](const asio::error_code& ec) {
+                self->onServerRead(ec);
+            })
     );
 }
 
-void Session::onClientRead(const asio::error_code& ec, std::size_t bytesRead) {
+void Session::onClientRead(const asio::error_code& waitEc) {
+    asio::error_code ec = waitEc;
+    asio::mutable_buffer space;
+    std::size_t bytesRead = 0;
+    if (!ec) {
+        space = clientToServerBuf_.prepareWrite(calculateBudget());
+        if (space.size() == 0) {
+            clientReadPaused_ = true;  // Buffer full; write completion resumes
+            return;
+        }
+        bytesRead = clientSocket_.readSome(space, ec);
+        if (ec == asio::error::would_block) {
+            startClientRead();
+            return;
+        }
+    }
+
     if (ec) {
         if (ec == asio::error::eof || ec == asio::error::connection_reset) {
             globalLogger().debug(sessionId_, clientPktSeq_, "client_eof", "upstream");
+            releaseReordered(Direction::ClientToServer);
             closeClientRead();
         } else if (ec != asio::error::operation_aborted) {
             globalLogger().warn(sessionId_, clientPktSeq_, "client_read_error", "upstream",
@@ -160,21 +200,41 @@ void Session::onClientRead(const asio::error_code& ec, std::size_t bytesRead) {
     recordActivity();
     ++clientPktSeq_;
 
-    std::span<uint8_t> data(clientReadBuf_.data(), bytesRead);
+    // Uncommitted tail of the outbound buffer: faults apply in place
+    std::span<uint8_t> data(static_cast<uint8_t*>(space.data()), bytesRead);
     processClientData(data);
+    clientToServerBuf_.trim();  // Nothing committed (dropped/delayed): return storage
 
-    // Check backpressure
-    if (clientToServerBuf_.shouldPauseReading()) {
+    // Check backpressure (write buffer and delay queue)
+    if (clientToServerReleased_.shouldPauseReading(clientToServerBuf_) ||
+        clientToServerDelay_.shouldPauseReading()) {
         clientReadPaused_ = true;
     } else {
         startClientRead();
     }
 }
 
-void Session::onServerRead(const asio::error_code& ec, std::size_t bytesRead) {
+void Session::onServerRead(const asio::error_code& waitEc) {
+    asio::error_code ec = waitEc;
+    asio::mutable_buffer space;
+    std::size_t bytesRead = 0;
+    if (!ec) {
+        space = serverToClientBuf_.prepareWrite(calculateBudget());
+        if (space.size() == 0) {
+            serverReadPaused_ = true;  // Buffer full; write completion resumes
+            return;
+        }
+        bytesRead = serverSocket_.readSome(space, ec);
+        if (ec == asio::error::would_block) {
+            startServerRead();
+            return;
+        }
+    }
+
     if (ec) {
         if (ec == asio::error::eof || ec == asio::error::connection_reset) {
             globalLogger().debug(sessionId_, serverPktSeq_, "server_eof", "downstream");
+            releaseReordered(Direction::ServerToClient);
             closeServerRead();
         } else if (ec != asio::error::operation_aborted) {
             globalLogger().warn(sessionId_, serverPktSeq_, "server_read_error", "downstream",
@@ -187,11 +247,14 @@ void Session::onServerRead(const asio::error_code& ec, std::size_t bytesRead) {
     recordActivity();
     ++serverPktSeq_;
 
-    std::span<uint8_t> data(serverReadBuf_.data(), bytesRead);
+    // Uncommitted tail of the outbound buffer: faults apply in place
+    std::span<uint8_t> data(static_cast<uint8_t*>(space.data()), bytesRead);
     processServerData(data);
+    serverToClientBuf_.trim();  // Nothing committed (dropped/delayed): return storage
 
-    // Check backpressure
-    if (serverToClientBuf_.shouldPauseReading()) {
+    // Check backpressure (write buffer and delay queue)
+    if (serverToClientReleased_.shouldPauseReading(serverToClientBuf_) ||
+        serverToClientDelay_.shouldPauseReading()) {
         serverReadPaused_ = true;
     } else {
         startServerRead();
@@ -201,7 +264,8 @@ void Session::onServerRead(const asio::error_code& ec, std::size_t bytesRead) {
 void Session::processClientData(std::span<uint8_t> data) {
     // Make anomaly decision
     auto decision = engine_.decide(data, Direction::ClientToServer,
-                                    sessionId_, clientPktSeq_, currentProfile_);
+                                    sessionId_, clientPktSeq_, *plan_,
+                                    &clientToServerDecision_);
 
     switch (decision.action) {
         case AnomalyDecision::Action::Drop:
@@ -217,9 +281,7 @@ void Session::processClientData(std::span<uint8_t> data) {
             return;
 
         case AnomalyDecision::Action::Stall:
-            globalLogger().info(sessionId_, clientPktSeq_, "stall", "upstream");
-            globalMetrics().incrementStallEvents();
-            clientReadPaused_ = true;
+            stallRead(Direction::ClientToServer, data, clientPktSeq_, decision.stallMs);
             return;
 
         case AnomalyDecision::Action::Corrupt:
@@ -227,40 +289,46 @@ void Session::processClientData(std::span<uint8_t> data) {
             globalLogger().debug(sessionId_, clientPktSeq_, "corrupt", "upstream");
             break;
 
+        case AnomalyDecision::Action::Reorder:
+            if (holdForReorder(Direction::ClientToServer, data, clientPktSeq_,
+                               decision.delayUs)) {
+                return;
+            }
+            break;  // A segment is already held: this one goes in order
+
         default:
             break;
     }
 
     // Handle delay
-    if (decision.delayMs > 0) {
+    if (decision.delayUs > 0) {
         globalLogger().debug(sessionId_, clientPktSeq_, "delay", "upstream",
-                            "ms=" + std::to_string(decision.delayMs));
+                            "us=" + std::to_string(decision.delayUs));
         globalMetrics().incrementPacketsDelayed();
-        globalMetrics().observeLatencyInjected(decision.delayMs);
+        globalMetrics().observeLatencyInjected(decision.delayUs);
 
         auto releaseTime = std::chrono::steady_clock::now() + 
-                          std::chrono::milliseconds(decision.delayMs);
+                          std::chrono::microseconds(decision.delayUs);
         
-        std::vector<uint8_t> payload(data.begin(), data.end());
-        clientToServerDelay_.push(std::move(payload), releaseTime,
+        clientToServerDelay_.push(data, releaseTime,
                                   clientPktSeq_, profileVersion_, 0);
         
-        // Schedule timer if needed
-        if (delayTimerId_ == 0) {
-            scheduleDelayFlush();
-        }
+        scheduleDelayFlush();
     } else {
-        // Forward immediately
-        clientToServerBuf_.append(data.data(), data.size());
+        // Forward immediately: data already sits in the buffer, just commit it
+        clientToServerBuf_.commitWrite(data.size());
         globalMetrics().addBytesUpstream(data.size());
         startServerWrite();
     }
+
+    segmentPassed(Direction::ClientToServer);
 }
 
 void Session::processServerData(std::span<uint8_t> data) {
     // Make anomaly decision
     auto decision = engine_.decide(data, Direction::ServerToClient,
-                                    sessionId_, serverPktSeq_, currentProfile_);
+                                    sessionId_, serverPktSeq_, *plan_,
+                                    &serverToClientDecision_);
 
     switch (decision.action) {
         case AnomalyDecision::Action::Drop:
@@ -276,9 +344,7 @@ void Session::processServerData(std::span<uint8_t> data) {
             return;
 
         case AnomalyDecision::Action::Stall:
-            globalLogger().info(sessionId_, serverPktSeq_, "stall", "downstream");
-            globalMetrics().incrementStallEvents();
-            serverReadPaused_ = true;
+            stallRead(Direction::ServerToClient, data, serverPktSeq_, decision.stallMs);
             return;
 
         case AnomalyDecision::Action::Corrupt:
@@ -286,39 +352,122 @@ void Session::processServerData(std::span<uint8_t> data) {
             globalLogger().debug(sessionId_, serverPktSeq_, "corrupt", "downstream");
             break;
 
+        case AnomalyDecision::Action::Reorder:
+            if (holdForReorder(Direction::ServerToClient, data, serverPktSeq_,
+                               decision.delayUs)) {
+                return;
+            }
+            break;
+
         default:
             break;
     }
 
     // Handle delay
-    if (decision.delayMs > 0) {
+    if (decision.delayUs > 0) {
         globalLogger().debug(sessionId_, serverPktSeq_, "delay", "downstream",
-                            "ms=" + std::to_string(decision.delayMs));
+                            "us=" + std::to_string(decision.delayUs));
         globalMetrics().incrementPacketsDelayed();
-        globalMetrics().observeLatencyInjected(decision.delayMs);
+        globalMetrics().observeLatencyInjected(decision.delayUs);
 
         auto releaseTime = std::chrono::steady_clock::now() + 
-                          std::chrono::milliseconds(decision.delayMs);
+                          std::chrono::microseconds(decision.delayUs);
         
-        std::vector<uint8_t> payload(data.begin(), data.end());
-        serverToClientDelay_.push(std::move(payload), releaseTime,
+        serverToClientDelay_.push(data, releaseTime,
                                   serverPktSeq_, profileVersion_, 1);
-        
-        if (delayTimerId_ == 0) {
-            scheduleDelayFlush();
-        }
+
+        scheduleDelayFlush();
     } else {
-        // Forward immediately
-        serverToClientBuf_.append(data.data(), data.size());
+        // Forward immediately: data already sits in the buffer, just commit it
+        serverToClientBuf_.commitWrite(data.size());
         globalMetrics().addBytesDownstream(data.size());
         startClientWrite();
     }
+
+    segmentPassed(Direction::ServerToClient);
+}
+
+bool Session::holdForReorder(Direction direction, std::span<const uint8_t> data,
+                             uint64_t packetSeq, uint32_t delayUs) {
+    bool c2s = direction == Direction::ClientToServer;
+    ReorderSlot& slot = c2s ? c2sReorder_ : s2cReorder_;
+    if (slot.held) return false;  // Window holds one segment per direction
+
+    // Bytes wait in the delay queue's arena, outside its release order
+    DelayQueue& queue = c2s ? clientToServerDelay_ : serverToClientDelay_;
+    slot.held = queue.stash(data, packetSeq, profileVersion_, static_cast<uint8_t>(direction));
+    if (!slot.held) return false;
+
+    const auto& profile = c2s ? plan_->profile.clientToServer : plan_->profile.serverToClient;
+    slot.remaining = profile.reorderDistance;
+    slot.delayUs = delayUs;
+
+    // Request/response traffic may never send N more segments: bound the hold
+    slot.timerId = scheduler_.scheduleGuarded(
+        std::chrono::milliseconds(ConfigLimits::MAX_REORDER_HOLD_MS),
+        weak_from_this(),
+        [direction](Session::Ptr self) {
+            (direction == Direction::ClientToServer ? self->c2sReorder_
+                                                    : self->s2cReorder_).timerId = 0;
+            self->releaseReordered(direction);
+        });
+
+    globalLogger().debug(sessionId_, packetSeq, "reorder", c2s ? "upstream" : "downstream",
+                         "distance=" + std::to_string(slot.remaining));
+    globalMetrics().incrementPacketsReordered();
+    return true;
+}
+
+void Session::stallRead(Direction direction, std::span<const uint8_t> data,
+                        uint64_t packetSeq, uint32_t stallMs) {
+    bool c2s = direction == Direction::ClientToServer;
+    globalLogger().info(sessionId_, packetSeq, "stall", c2s ? "upstream" : "downstream",
+                        "ms=" + std::to_string(stallMs));
+    globalMetrics().incrementStallEvents();
+
+    // The triggering bytes go out when the stall ends, ahead of anything read later
+    auto stallFor = std::chrono::milliseconds(stallMs);
+    DelayQueue& queue = c2s ? clientToServerDelay_ : serverToClientDelay_;
+    queue.push(data, std::chrono::steady_clock::now() + stallFor,
+               packetSeq, profileVersion_, static_cast<uint8_t>(direction));
+    scheduleDelayFlush();
+
+    (c2s ? clientReadPaused_ : serverReadPaused_) = true;
+    (c2s ? clientStalled_ : serverStalled_) = true;
+    (c2s ? clientStallTimerId_ : serverStallTimerId_) = scheduler_.scheduleGuarded(
+        stallFor, weak_from_this(),
+        [direction](Session::Ptr self) { self->onStallTimeout(direction); });
+}
+
+void Session::segmentPassed(Direction direction) {
+    ReorderSlot& slot = direction == Direction::ClientToServer ? c2sReorder_ : s2cReorder_;
+    if (slot.held && --slot.remaining == 0) {
+        releaseReordered(direction);
+    }
+}
+
+void Session::releaseReordered(Direction direction) {
+    bool c2s = direction == Direction::ClientToServer;
+    ReorderSlot& slot = c2s ? c2sReorder_ : s2cReorder_;
+    if (!slot.held) return;
+
+    if (slot.timerId) {
+        scheduler_.cancel(slot.timerId);
+        slot.timerId = 0;
+    }
+
+    // Queued behind everything already forwarded or delayed
+    DelayQueue& queue = c2s ? clientToServerDelay_ : serverToClientDelay_;
+    queue.enqueueStashed(*slot.held, std::chrono::steady_clock::now() +
+                                     std::chrono::microseconds(slot.delayUs));
+    slot.held.reset();
+    scheduleDelayFlush();
 }
 
 void Session::scheduleDelayFlush() {
-    auto now = std::chrono::steady_clock::now();
-    auto nextC2S = clientToServerDelay_.nextReleaseTime();
-    auto nextS2C = serverToClientDelay_.nextReleaseTime();
+    // A due packet waiting for buffer room is retried by write completion
+    auto nextC2S = c2sFlushBlocked_ ? std::nullopt : clientToServerDelay_.nextReleaseTime();
+    auto nextS2C = s2cFlushBlocked_ ? std::nullopt : serverToClientDelay_.nextReleaseTime();
 
     std::optional<std::chrono::steady_clock::time_point> next;
     if (nextC2S && nextS2C) {
@@ -331,17 +480,19 @@ void Session::scheduleDelayFlush() {
         return;
     }
 
-    auto delay = std::chrono::duration_cast<std::chrono::milliseconds>(*next - now);
-    if (delay.count() < 0) delay = std::chrono::milliseconds(0);
+    // The shard-wide releaser already wakes us by the registered deadline
+    if (*next >= releaseDeadline_) return;
 
-    delayTimerId_ = scheduler_.scheduleGuarded(
-        delay, weak_from_this(),
-        [](Session::Ptr self) { self->onDelayExpired(); }
-    );
+    releaseDeadline_ = *next;
+    bool precise = plan_->profile.clientToServer.preciseLatency() ||
+                   plan_->profile.serverToClient.preciseLatency();
+    releaser_.request(*next, releaseHandle_, precise);
 }
 
-void Session::onDelayExpired() {
-    delayTimerId_ = 0;
+void Session::onReleaseDue(std::chrono::steady_clock::time_point when) {
+    if (when != releaseDeadline_) return;  // Superseded by an earlier request
+
+    releaseDeadline_ = std::chrono::steady_clock::time_point::max();
     flushDelayQueues();
     scheduleDelayFlush();
 }
@@ -350,51 +501,329 @@ void Session::flushDelayQueues() {
     auto now = std::chrono::steady_clock::now();
 
     // Flush client-to-server delays
-    while (auto pkt = clientToServerDelay_.popReady(now)) {
-        clientToServerBuf_.append(pkt->payload.data(), pkt->payload.size());
-        globalMetrics().addBytesUpstream(pkt->payload.size());
-    }
-    if (clientToServerBuf_.readable() > 0 && !serverWriteInProgress_) {
+    std::size_t upstream = drainDelayQueue(clientToServerDelay_, clientToServerBuf_,
+                                           clientToServerReleased_, now, c2sFlushBlocked_);
+    globalMetrics().addBytesUpstream(upstream);
+    if ((clientToServerBuf_.readable() > 0 || !clientToServerReleased_.empty()) &&
+        !serverWriteInProgress_) {
         startServerWrite();
     }
+    maybeResumeClientRead();
 
     // Flush server-to-client delays
-    while (auto pkt = serverToClientDelay_.popReady(now)) {
-        serverToClientBuf_.append(pkt->payload.data(), pkt->payload.size());
-        globalMetrics().addBytesDownstream(pkt->payload.size());
-    }
-    if (serverToClientBuf_.readable() > 0 && !clientWriteInProgress_) {
+    std::size_t downstream = drainDelayQueue(serverToClientDelay_, serverToClientBuf_,
+                                             serverToClientReleased_, now, s2cFlushBlocked_);
+    globalMetrics().addBytesDownstream(downstream);
+    if ((serverToClientBuf_.readable() > 0 || !serverToClientReleased_.empty()) &&
+        !clientWriteInProgress_) {
         startClientWrite();
     }
+    maybeResumeServerRead();
+}
+
+std::size_t Session::drainDelayQueue(DelayQueue& queue, Buffer& buf, ReleaseList& released,
+                                     std::chrono::steady_clock::time_point now,
+                                     bool& blocked) {
+    // Whole packets only: a partial append would cut bytes out of the stream.
+    // Released packets count against the Buffer's room as if copied into it.
+    std::size_t moved = 0;
+    if (released.canAccept(buf)) {
+        // Hand payloads to the writer in place; freed when the write completes
+        std::size_t room = buf.writable() - std::min(buf.writable(), released.bytes());
+        while (auto pkt = queue.popReady(now, room)) {
+            released.push(*pkt, buf);
+            moved += pkt->length;
+            room -= pkt->length;
+        }
+    } else {
+        // Forwarded bytes already follow the released ones: copy in behind them,
+        // bounded by the storage an in-flight write has pinned
+        std::size_t room = buf.writable() - std::min(buf.writable(), released.bytes());
+        room = std::min(room, buf.appendable());
+        while (auto pkt = queue.popReady(now, room)) {
+            auto payload = queue.payload(*pkt);
+            buf.append(payload.data(), payload.size());
+            moved += payload.size();
+            room -= payload.size();
+            queue.release(*pkt);
+        }
+    }
+    blocked = queue.hasReady(now);
+    return moved;
+}
+
+void Session::maybeResumeClientRead() {
+    // Resume client reads once both the buffer and the delay queue drained
+    if (clientReadPaused_ && !clientStalled_ &&
+        clientToServerReleased_.shouldResumeReading(clientToServerBuf_) &&
+        clientToServerDelay_.shouldResumeReading()) {
+        clientReadPaused_ = false;
+        startClientRead();
+    }
+}
+
+void Session::maybeResumeServerRead() {
+    if (serverReadPaused_ && !serverStalled_ &&
+        serverToClientReleased_.shouldResumeReading(serverToClientBuf_) &&
+        serverToClientDelay_.shouldResumeReading()) {
+        serverReadPaused_ = false;
+        startServerRead();
+    }
+}
+
+void Session::refreshProfile() {
+    uint64_t generation = config_.generation();
+    if (generation == profileGeneration_) return;
+
+    profileGeneration_ = generation;
+    plan_ = config_.getPlan("default");
+    profileVersion_ = plan_->profile.version;
+
+    // Client->server bytes are paced on the server socket and vice versa
+    clientToServerBucket_.setRate(plan_->clientToServer.throttleBytesPerSec);
+    serverToClientBucket_.setRate(plan_->serverToClient.throttleBytesPerSec);
+}
+
+bool Session::canSplice(Direction direction) {
+    if (!SplicePipe::supported()) return false;
+
+    bool c2s = direction == Direction::ClientToServer;
+    const auto& profile = c2s ? plan_->profile.clientToServer 
+                              : plan_->profile.serverToClient;
+    if (profile.hasFaults()) return false;
+
+    // Switch only once the copying path has drained so bytes stay in order
+    const Buffer& buf = c2s ? clientToServerBuf_ : serverToClientBuf_;
+    const DelayQueue& delay = c2s ? clientToServerDelay_ : serverToClientDelay_;
+    const ReleaseList& released = c2s ? clientToServerReleased_ : serverToClientReleased_;
+    bool held = (c2s ? c2sReorder_ : s2cReorder_).held.has_value();
+    bool writing = c2s ? serverWriteInProgress_ : clientWriteInProgress_;
+    bool writeOpen = c2s ? channels_.serverWriteOpen : channels_.clientWriteOpen;
+    if (!buf.empty() || !delay.empty() || !released.empty() || held || writing || !writeOpen) {
+        return false;
+    }
+
+    return (c2s ? clientToServerPipe_ : serverToClientPipe_).open();
+}
+
+void Session::startClientSplice() {
+    clientSocket_.asyncWaitReadable(
+        makeAllocHandler(clientReadMem_,
+            [self = shared_from_this()](const asio::error_code& ec) {
+                self->onClientSpliceReadable(ec);
+            })
+    );
+}
+
+void Session::startServerSplice() {
+    serverSocket_.asyncWaitReadable(
+        makeAllocHandler(serverReadMem_,
+            [self = shared_from_this()](const asio::error_code& ec) {
+                self->onServerSpliceReadable(ec);
+            })
+    );
+}
+
+void Session::onClientSpliceReadable(const asio::error_code& ec) {
+    if (ec) {
+        onClientRead(ec);
+        return;
+    }
+
+    asio::error_code spliceEc;
+    std::size_t n = clientToServerPipe_.fill(clientSocket_.native(), spliceEc);
+    if (spliceEc == asio::error::would_block) {
+        startClientSplice();
+        return;
+    }
+    if (spliceEc) {
+        onClientRead(spliceEc);
+        return;
+    }
+    if (n == 0) {
+        // EOF: pipe is empty (we only fill after a full drain), pass FIN on
+        globalLogger().debug(sessionId_, clientPktSeq_, "client_eof", "upstream");
+        closeClientRead();
+        closeServerWrite();
+        return;
+    }
+
+    recordActivity();
+    ++clientPktSeq_;
+    globalMetrics().addBytesUpstream(n);
+    pumpClientSplice();
+}
+
+void Session::onServerSpliceReadable(const asio::error_code& ec) {
+    if (ec) {
+        onServerRead(ec);
+        return;
+    }
+
+    asio::error_code spliceEc;
+    std::size_t n = serverToClientPipe_.fill(serverSocket_.native(), spliceEc);
+    if (spliceEc == asio::error::would_block) {
+        startServerSplice();
+        return;
+    }
+    if (spliceEc) {
+        onServerRead(spliceEc);
+        return;
+    }
+    if (n == 0) {
+        globalLogger().debug(sessionId_, serverPktSeq_, "server_eof", "downstream");
+        closeServerRead();
+        closeClientWrite();
+        return;
+    }
+
+    recordActivity();
+    ++serverPktSeq_;
+    globalMetrics().addBytesDownstream(n);
+    pumpServerSplice();
+}
+
+void Session::pumpClientSplice() {
+    asio::error_code ec;
+    clientToServerPipe_.drain(serverSocket_.native(), ec);
+    if (ec && ec != asio::error::would_block) {
+        globalLogger().warn(sessionId_, 0, "server_write_error", "upstream",
+                           "error=" + ec.message());
+        closeServerWrite();
+        return;
+    }
+
+    if (clientToServerPipe_.pending() > 0) {
+        serverWriteInProgress_ = true;
+        serverSocket_.asyncWaitWritable(
+            makeAllocHandler(serverWriteMem_,
+                [self = shared_from_this()](const asio::error_code& ec) {
+                    self->onServerSpliceWritable(ec);
+                })
+        );
+        return;
+    }
+
+    // Pipe drained: next read re-checks the profile and may leave pass-through
+    startClientRead();
+}
+
+void Session::pumpServerSplice() {
+    asio::error_code ec;
+    serverToClientPipe_.drain(clientSocket_.native(), ec);
+    if (ec && ec != asio::error::would_block) {
+        globalLogger().warn(sessionId_, 0, "client_write_error", "downstream",
+                           "error=" + ec.message());
+        closeClientWrite();
+        return;
+    }
+
+    if (serverToClientPipe_.pending() > 0) {
+        clientWriteInProgress_ = true;
+        clientSocket_.asyncWaitWritable(
+            makeAllocHandler(clientWriteMem_,
+                [self = shared_from_this()](const asio::error_code& ec) {
+                    self->onClientSpliceWritable(ec);
+                })
+        );
+        return;
+    }
+
+    startServerRead();
+}
+
+void Session::onServerSpliceWritable(const asio::error_code& ec) {
+    serverWriteInProgress_ = false;
+
+    if (ec) {
+        if (ec != asio::error::operation_aborted) {
+            globalLogger().warn(sessionId_, 0, "server_write_error", "upstream",
+                               "error=" + ec.message());
+        }
+        closeServerWrite();
+        return;
+    }
+
+    recordActivity();
+    pumpClientSplice();
+}
+
+void Session::onClientSpliceWritable(const asio::error_code& ec) {
+    clientWriteInProgress_ = false;
+
+    if (ec) {
+        if (ec != asio::error::operation_aborted) {
+            globalLogger().warn(sessionId_, 0, "client_write_error", "downstream",
+                               "error=" + ec.message());
+        }
+        closeClientWrite();
+        return;
+    }
+
+    recordActivity();
+    pumpServerSplice();
 }
 
 void Session::startClientWrite() {
-    if (!channels_.clientWriteOpen || clientWriteInProgress_) return;
-    if (serverToClientBuf_.empty()) return;
+    if (!channels_.clientWriteOpen || clientWriteInProgress_ || clientPaceTimerId_) return;
+    if (serverToClientBuf_.empty() && serverToClientReleased_.empty()) return;
+
+    std::size_t limit = SIZE_MAX;
+    if (serverToClientBucket_.limited()) {
+        std::size_t want = serverToClientBuf_.readable() + serverToClientReleased_.bytes();
+        limit = serverToClientBucket_.take(want, std::chrono::steady_clock::now());
+        if (limit == 0) {
+            // Out of tokens: come back when a worthwhile chunk is allowed
+            clientPaceTimerId_ = scheduler_.scheduleGuarded(
+                std::chrono::ceil<std::chrono::milliseconds>(
+                    serverToClientBucket_.waitFor(want)),
+                weak_from_this(),
+                [](Session::Ptr self) {
+                    self->clientPaceTimerId_ = 0;
+                    self->startClientWrite();
+                });
+            return;
+        }
+    }
 
     clientWriteInProgress_ = true;
     clientSocket_.asyncWrite(
-        serverToClientBuf_.dataToSend(),
-        asio::bind_executor(strand_,
+        serverToClientReleased_.gather(serverToClientBuf_, serverToClientDelay_, limit),
+        makeAllocHandler(clientWriteMem_,
             [self = shared_from_this()](const asio::error_code& ec, std::size_t n) {
                 self->onClientWrite(ec, n);
-            }
-        )
+            })
     );
 }
 
 void Session::startServerWrite() {
-    if (!channels_.serverWriteOpen || serverWriteInProgress_) return;
-    if (clientToServerBuf_.empty()) return;
+    if (!channels_.serverWriteOpen || serverWriteInProgress_ || serverPaceTimerId_) return;
+    if (clientToServerBuf_.empty() && clientToServerReleased_.empty()) return;
+
+    std::size_t limit = SIZE_MAX;
+    if (clientToServerBucket_.limited()) {
+        std::size_t want = clientToServerBuf_.readable() + clientToServerReleased_.bytes();
+        limit = clientToServerBucket_.take(want, std::chrono::steady_clock::now());
+        if (limit == 0) {
+            serverPaceTimerId_ = scheduler_.scheduleGuarded(
+                std::chrono::ceil<std::chrono::milliseconds>(
+                    clientToServerBucket_.waitFor(want)),
+                weak_from_this(),
+                [](Session::Ptr self) {
+                    self->serverPaceTimerId_ = 0;
+                    self->startServerWrite();
+                });
+            return;
+        }
+    }
 
     serverWriteInProgress_ = true;
     serverSocket_.asyncWrite(
-        clientToServerBuf_.dataToSend(),
-        asio::bind_executor(strand_,
+        clientToServerReleased_.gather(clientToServerBuf_, clientToServerDelay_, limit),
+        makeAllocHandler(serverWriteMem_,
             [self = shared_from_this()](const asio::error_code& ec, std::size_t n) {
                 self->onServerWrite(ec, n);
-            }
-        )
+            })
     );
 }
 
@@ -411,17 +840,19 @@ void Session::onClientWrite(const asio::error_code& ec, std::size_t bytesWritten
     }
 
     recordActivity();
-    serverToClientBuf_.consume(bytesWritten);
+    serverToClientReleased_.consume(bytesWritten, serverToClientBuf_, serverToClientDelay_);
     globalMetrics().observeBufferOccupancy(serverToClientBuf_.readable());
 
-    // Resume server reads if backpressure cleared
-    if (serverReadPaused_ && serverToClientBuf_.shouldResumeReading()) {
-        serverReadPaused_ = false;
-        startServerRead();
+    // Room freed for a due delayed packet that did not fit earlier
+    if (s2cFlushBlocked_) {
+        flushDelayQueues();
+        scheduleDelayFlush();
     }
 
+    maybeResumeServerRead();
+
     // Continue writing if more data
-    if (serverToClientBuf_.readable() > 0) {
+    if (serverToClientBuf_.readable() > 0 || !serverToClientReleased_.empty()) {
         startClientWrite();
     } else if (!channels_.serverReadOpen) {
         // Server finished sending, close client write
@@ -442,17 +873,18 @@ void Session::onServerWrite(const asio::error_code& ec, std::size_t bytesWritten
     }
 
     recordActivity();
-    clientToServerBuf_.consume(bytesWritten);
+    clientToServerReleased_.consume(bytesWritten, clientToServerBuf_, clientToServerDelay_);
     globalMetrics().observeBufferOccupancy(clientToServerBuf_.readable());
 
-    // Resume client reads if backpressure cleared
-    if (clientReadPaused_ && clientToServerBuf_.shouldResumeReading()) {
-        clientReadPaused_ = false;
-        startClientRead();
+    if (c2sFlushBlocked_) {
+        flushDelayQueues();
+        scheduleDelayFlush();
     }
 
+    maybeResumeClientRead();
+
     // Continue writing if more data
-    if (clientToServerBuf_.readable() > 0) {
+    if (clientToServerBuf_.readable() > 0 || !clientToServerReleased_.empty()) {
         startServerWrite();
     } else if (!channels_.clientReadOpen) {
         // Client finished sending, close server write
@@ -520,10 +952,6 @@ void Session::initiateShutdown() {
     clientSocket_.cancelPending();
     serverSocket_.cancelPending();
     
-    // Flush remaining data with dynamic linger
-    auto pendingBytes = clientToServerBuf_.readable() + serverToClientBuf_.readable() +
-                       clientToServerDelay_.totalBytes() + serverToClientDelay_.totalBytes();
-    
     // Simple linger - just close after flushing what we can
     checkFullyClosed();
 }
@@ -544,13 +972,9 @@ void Session::forceClose() {
     }
 }
 
-void Session::resetIdleTimer() {
-    if (idleTimerId_) {
-        scheduler_.cancel(idleTimerId_);
-    }
-    
+void Session::armIdleTimer(std::chrono::milliseconds delay) {
     idleTimerId_ = scheduler_.scheduleGuarded(
-        config_.serverConfig().idleTimeout,
+        delay,
         weak_from_this(),
         [](Session::Ptr self) { self->onIdleTimeout(); }
     );
@@ -565,25 +989,40 @@ void Session::onConnectTimeout() {
 
 void Session::onIdleTimeout() {
     idleTimerId_ = 0;
+
+    // Activity since arming pushed the deadline out: sleep for the remainder
+    auto idleTimeout = config_.serverConfig().idleTimeout;
+    auto idle = std::chrono::steady_clock::now() - lastActivity_;
+    if (idle < idleTimeout) {
+        armIdleTimer(std::chrono::ceil<std::chrono::milliseconds>(idleTimeout - idle));
+        return;
+    }
+
     globalLogger().info(sessionId_, 0, "idle_timeout");
     initiateShutdown();
 }
 
-void Session::onStallTimeout() {
-    stallTimerId_ = 0;
-    globalLogger().warn(sessionId_, 0, "stall_timeout");
-    forceClose();
+void Session::onStallTimeout(Direction direction) {
+    bool c2s = direction == Direction::ClientToServer;
+    (c2s ? clientStallTimerId_ : serverStallTimerId_) = 0;
+    (c2s ? clientStalled_ : serverStalled_) = false;
+    globalLogger().debug(sessionId_, 0, "stall_end", c2s ? "upstream" : "downstream");
+
+    if (c2s) {
+        maybeResumeClientRead();
+    } else {
+        maybeResumeServerRead();
+    }
 }
 
 void Session::recordActivity() {
     lastActivity_ = std::chrono::steady_clock::now();
-    resetIdleTimer();
 }
 
 std::size_t Session::calculateBudget() const {
     if (auto mgr = manager_.lock()) {
         float pressure = static_cast<float>(mgr->sessionCount()) / 
-                        ConfigLimits::MAX_SESSIONS;
+                        mgr->maxSessions();
         std::size_t budget = static_cast<std::size_t>(
             16384.0f / std::max(1.0f, pressure * 4.0f)
         );
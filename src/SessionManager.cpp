@@ -7,21 +7,32 @@ namespace shakyline {
 SessionManager::Ptr SessionManager::create(
     asio::io_context& io,
     Scheduler& scheduler,
+    ReleaseScheduler& releaser,
     const AnomalyEngine& engine,
-    ConfigManager& config
+    ConfigManager& config,
+    std::size_t shardIndex,
+    std::size_t shardCount
 ) {
-    return Ptr(new SessionManager(io, scheduler, engine, config));
+    return Ptr(new SessionManager(io, scheduler, releaser, engine, config,
+                                  shardIndex, shardCount));
 }
 
 SessionManager::SessionManager(
     asio::io_context& io,
     Scheduler& scheduler,
+    ReleaseScheduler& releaser,
     const AnomalyEngine& engine,
-    ConfigManager& config
+    ConfigManager& config,
+    std::size_t shardIndex,
+    std::size_t shardCount
 ) : io_(io)
   , scheduler_(scheduler)
+  , releaser_(releaser)
   , engine_(engine)
   , config_(config)
+  , shardIndex_(shardIndex)
+  , shardCount_(std::max<std::size_t>(shardCount, 1))
+  , maxSessions_(ConfigLimits::MAX_SESSIONS / shardCount_)
 {}
 
 SessionManager::~SessionManager() {
@@ -35,11 +46,11 @@ Session::Ptr SessionManager::createSession(Socket clientSocket) {
         return nullptr;
     }
 
-    uint64_t sessionId = nextSessionId_.fetch_add(1);
+    uint64_t sessionId = nextSessionId_.fetch_add(1) * shardCount_ + shardIndex_;
     
     auto session = Session::create(
         io_, std::move(clientSocket), weak_from_this(),
-        scheduler_, engine_, config_, sessionId
+        scheduler_, releaser_, engine_, config_, sessionId
     );
 
     {
@@ -47,14 +58,57 @@ Session::Ptr SessionManager::createSession(Socket clientSocket) {
         sessions_[sessionId] = session;
     }
 
-    // Post start to session's strand (post-construction activation)
-    asio::post(session->strand(), [session, upstream = upstreamEndpoint_]() {
+    // Post start to the session's loop (post-construction activation)
+    asio::post(session->executor(), [session, upstream = upstreamEndpoint_]() {
         session->start(upstream);
     });
 
     return session;
 }
 
+void SessionManager::adoptSocket(asio::ip::tcp::socket::protocol_type protocol,
+                                 asio::ip::tcp::socket::native_handle_type fd) {
+    asio::ip::tcp::socket socket(io_);
+    asio::error_code ec;
+    socket.assign(protocol, fd, ec);
+    if (ec) {
+        globalLogger().warn(0, 0, "handoff_failed", "", "error=" + ec.message());
+        return;
+    }
+
+    pendingHandoffs_.fetch_add(1);
+    asio::post(io_, [self = shared_from_this(), s = std::move(socket)]() mutable {
+        self->pendingHandoffs_.fetch_sub(1);
+        if (!self->createSession(Socket(std::move(s)))) {
+            globalLogger().warn(0, 0, "session_rejected", "", "reason=handoff");
+        }
+    });
+}
+
+void SessionManager::sampleLoad(std::chrono::microseconds loopLag) {
+    uint64_t queued = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& [id, session] : sessions_) {
+            queued += session->queuedBytes();
+        }
+    }
+    queuedBytes_.store(queued, std::memory_order_relaxed);
+    loopLagUs_.store(static_cast<uint64_t>(std::max<int64_t>(loopLag.count(), 0)),
+                     std::memory_order_relaxed);
+}
+
+uint64_t SessionManager::loadScore() const noexcept {
+    uint64_t sessions;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        sessions = sessions_.size();
+    }
+    return sessions + pendingHandoffs_.load(std::memory_order_relaxed) +
+           queuedBytes_.load(std::memory_order_relaxed) / Buffer::DEFAULT_CAPACITY +
+           loopLagUs_.load(std::memory_order_relaxed) / 1000;
+}
+
 void SessionManager::removeSession(uint64_t sessionId) {
     std::lock_guard<std::mutex> lock(mutex_);
     sessions_.erase(sessionId);
@@ -81,8 +135,11 @@ void SessionManager::shutdownAll() {
         }
     }
 
+    // Move the only extra reference into the handler so a session that
+    // ends is destroyed on its loop thread, where its timers live
     for (auto& session : toShutdown) {
-        asio::post(session->strand(), [session]() {
+        auto executor = session->executor();
+        asio::post(executor, [session = std::move(session)]() {
             session->initiateShutdown();
         });
     }
@@ -98,7 +155,8 @@ void SessionManager::forceCloseAll() {
     }
 
     for (auto& session : toClose) {
-        asio::post(session->strand(), [session]() {
+        auto executor = session->executor();
+        asio::post(executor, [session = std::move(session)]() {
             session->forceClose();
         });
     }
@@ -132,27 +190,26 @@ std::vector<uint64_t> SessionManager::getSessionIds() const {
 }
 
 bool SessionManager::canAccept() const {
-    return sessionCount() < ConfigLimits::MAX_SESSIONS;
+    return sessionCount() < maxSessions_;
 }
 
 bool SessionManager::tryAdmit() {
     std::size_t count = sessionCount();
-    std::size_t softLimit = ConfigLimits::MAX_SESSIONS * 
-                           ConfigLimits::SOFT_LIMIT_PERCENT / 100;
+    std::size_t softLimit = maxSessions_ * ConfigLimits::SOFT_LIMIT_PERCENT / 100;
     
     if (count < softLimit) {
         return true;
     }
     
-    if (count >= ConfigLimits::MAX_SESSIONS) {
+    if (count >= maxSessions_) {
         // At hard limit - try to shed oldest
         shedOldestIdle();
-        return sessionCount() < ConfigLimits::MAX_SESSIONS;
+        return sessionCount() < maxSessions_;
     }
     
     // Between soft and hard limit - probabilistic admission
     float probability = 1.0f - static_cast<float>(count - softLimit) / 
-                                (ConfigLimits::MAX_SESSIONS - softLimit);
+                                (maxSessions_ - softLimit);
     
     // Simple random check (not cryptographically secure, but fine for this)
     float roll = static_cast<float>(std::rand()) / RAND_MAX;
@@ -163,7 +220,8 @@ void SessionManager::shedOldestIdle() {
     auto oldest = findOldestIdle();
     if (oldest) {
         globalLogger().info(oldest->id(), 0, "session_shed", "", "reason=admission");
-        asio::post(oldest->strand(), [oldest]() {
+        auto executor = oldest->executor();
+        asio::post(executor, [oldest = std::move(oldest)]() {
             oldest->forceClose();
         });
     }
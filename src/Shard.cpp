@@ -0,0 +1,71 @@
+#include "shakyline/Shard.hpp"
+
+namespace shakyline {
+
+Shard::Shard(
+    std::size_t index,
+    std::size_t count,
+    const AnomalyEngine& engine,
+    ConfigManager& config
+) : index_(index)
+  , scheduler_(loop_.context())
+  , releaser_(loop_.context())
+  , sessionManager_(SessionManager::create(
+        loop_.context(), scheduler_, releaser_, engine, config, index, count))
+  , proxyServer_(loop_.context(), sessionManager_, config.serverConfig())
+  , loadTimer_(loop_.context())
+{
+    if (config.serverConfig().acceptMode == AcceptMode::Balanced) {
+        scheduleLoadSample();
+    }
+}
+
+Shard::~Shard() {
+    stop();
+
+    // Close sessions and let their aborted handlers run here, while the
+    // scheduler they cancel timers on is still alive (not in ~io_context)
+    proxyServer_.stop();
+    loadTimer_.cancel();
+    sessionManager_->forceCloseAll();
+    loop_.drain();
+}
+
+void Shard::start(int cpu, bool accept) {
+    if (accept) {
+        proxyServer_.start();
+    }
+    loop_.runInBackground(cpu);
+}
+
+void Shard::stopAccepting() {
+    // Acceptor is owned by the loop thread; close it there
+    loop_.post([this]() { proxyServer_.stop(); });
+}
+
+void Shard::shutdownSessions() {
+    sessionManager_->shutdownAll();
+}
+
+void Shard::forceCloseSessions() {
+    sessionManager_->forceCloseAll();
+}
+
+void Shard::stop() {
+    loop_.stop();
+    loop_.join();
+}
+
+void Shard::scheduleLoadSample() {
+    loadTimer_.expires_after(LOAD_SAMPLE_INTERVAL);
+    loadTimer_.async_wait([this](const asio::error_code& ec) {
+        if (ec) return;
+        // Lateness of this timer is how long ready work waits on the loop
+        auto lag = std::chrono::duration_cast<std::chrono::microseconds>(
+            asio::steady_timer::clock_type::now() - loadTimer_.expiry());
+        sessionManager_->sampleLoad(lag);
+        scheduleLoadSample();
+    });
+}
+
+} // namespace shakyline
@@ -0,0 +1,144 @@
+#include "shakyline/SpillStore.hpp"
+#include "shakyline/Logger.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace shakyline {
+
+namespace {
+// Written once in main() before any loop thread starts
+std::string g_spillDirectory;
+std::size_t g_spillMaxBytes = 0;
+}
+
+SpillStore::SpillStore(std::string directory, std::size_t maxBytes)
+    : directory_(std::move(directory))
+    , maxSegments_(maxBytes / SEGMENT_SIZE) {}
+
+void SpillStore::configure(std::string directory, std::size_t maxBytes) {
+    g_spillDirectory = std::move(directory);
+    g_spillMaxBytes = maxBytes;
+}
+
+bool SpillStore::enabled() noexcept {
+    return supported() && !g_spillDirectory.empty() && g_spillMaxBytes >= SEGMENT_SIZE;
+}
+
+std::size_t SpillStore::budget() noexcept {
+    return enabled() ? g_spillMaxBytes : 0;
+}
+
+std::shared_ptr<SpillStore> SpillStore::local() {
+    if (!enabled()) {
+        return nullptr;
+    }
+    // Queues keep their own reference, so segments can still be released
+    // after the loop thread (and this thread_local) has gone
+    thread_local auto store = std::make_shared<SpillStore>(g_spillDirectory, g_spillMaxBytes);
+    return store;
+}
+
+#ifdef __linux__
+
+bool SpillStore::supported() noexcept {
+    return true;
+}
+
+SpillStore::~SpillStore() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+    }
+}
+
+bool SpillStore::open() {
+    if (fd_ >= 0) return true;
+    if (failed_) return false;
+
+    std::string path = directory_ + "/shakyline-spill-XXXXXX";
+    fd_ = ::mkstemp(path.data());
+    if (fd_ < 0) {
+        failed_ = true;
+        globalLogger().warn(0, 0, "spill_open_failed", "",
+                            "dir=" + directory_ + " error=" + std::strerror(errno));
+        return false;
+    }
+    ::unlink(path.c_str());  // Anonymous: space is reclaimed when we exit
+    return true;
+}
+
+SpillStore::Segment SpillStore::acquire() {
+    if (inUse_ >= maxSegments_ || !open()) {
+        return {};
+    }
+
+    bool reused = !freeSegments_.empty();
+    uint32_t index = reused ? freeSegments_.back() : fileSegments_;
+    off_t offset = static_cast<off_t>(index) * static_cast<off_t>(SEGMENT_SIZE);
+
+    // Reserve the blocks up front (again for reused segments: release()
+    // punched them out). A sparse page the filesystem cannot back would
+    // raise SIGBUS on the first write; failing here lets the caller fall
+    // back to its no-spill path instead. Also extends the file for new ones.
+    if (::posix_fallocate(fd_, offset, static_cast<off_t>(SEGMENT_SIZE)) != 0) {
+        return {};
+    }
+    if (reused) {
+        freeSegments_.pop_back();
+    } else {
+        ++fileSegments_;
+    }
+
+    void* data = ::mmap(nullptr, SEGMENT_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, offset);
+    if (data == MAP_FAILED) {
+        freeSegments_.push_back(index);
+        return {};
+    }
+
+    ++inUse_;
+    return {static_cast<uint8_t*>(data), index};
+}
+
+void SpillStore::release(const Segment& segment) noexcept {
+    if (!segment.data) return;
+
+    ::munmap(segment.data, SEGMENT_SIZE);
+#ifdef FALLOC_FL_PUNCH_HOLE
+    ::fallocate(fd_, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+                static_cast<off_t>(segment.index) * static_cast<off_t>(SEGMENT_SIZE),
+                static_cast<off_t>(SEGMENT_SIZE));
+#endif
+    --inUse_;
+    try {
+        freeSegments_.push_back(segment.index);
+    } catch (...) {
+        // Segment is leaked from reuse only; the file keeps its size
+    }
+}
+
+#else
+
+bool SpillStore::supported() noexcept {
+    return false;
+}
+
+SpillStore::~SpillStore() = default;
+
+bool SpillStore::open() {
+    return fd_ >= 0;  // Never opened here
+}
+
+SpillStore::Segment SpillStore::acquire() {
+    return {};
+}
+
+void SpillStore::release(const Segment&) noexcept {}
+
+#endif
+
+} // namespace shakyline
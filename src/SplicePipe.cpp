@@ -0,0 +1,104 @@
+#include "shakyline/SplicePipe.hpp"
+
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace shakyline {
+
+SplicePipe::~SplicePipe() {
+    close();
+}
+
+#ifdef __linux__
+
+bool SplicePipe::supported() noexcept {
+    return true;
+}
+
+bool SplicePipe::open() noexcept {
+    if (isOpen()) return true;
+
+    int fds[2];
+    if (::pipe2(fds, O_NONBLOCK | O_CLOEXEC) != 0) {
+        return false;
+    }
+    readFd_ = fds[0];
+    writeFd_ = fds[1];
+
+    int size = ::fcntl(writeFd_, F_GETPIPE_SZ);
+    capacity_ = size > 0 ? static_cast<std::size_t>(size) : 64 * 1024;
+    pending_ = 0;
+    return true;
+}
+
+std::size_t SplicePipe::fill(int socketFd, asio::error_code& ec) noexcept {
+    ec.clear();
+    std::size_t room = capacity_ - pending_;
+    if (room == 0) return 0;
+
+    ssize_t n = ::splice(socketFd, nullptr, writeFd_, nullptr, room,
+                         SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (n < 0) {
+        ec = (errno == EAGAIN) 
+           ? asio::error_code(asio::error::would_block)
+           : asio::error_code(errno, asio::error::get_system_category());
+        return 0;
+    }
+    pending_ += static_cast<std::size_t>(n);
+    return static_cast<std::size_t>(n);
+}
+
+std::size_t SplicePipe::drain(int socketFd, asio::error_code& ec) noexcept {
+    ec.clear();
+    std::size_t total = 0;
+    while (pending_ > 0) {
+        ssize_t n = ::splice(readFd_, nullptr, socketFd, nullptr, pending_,
+                             SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+        if (n < 0) {
+            ec = (errno == EAGAIN)
+               ? asio::error_code(asio::error::would_block)
+               : asio::error_code(errno, asio::error::get_system_category());
+            break;
+        }
+        pending_ -= static_cast<std::size_t>(n);
+        total += static_cast<std::size_t>(n);
+    }
+    return total;
+}
+
+void SplicePipe::close() noexcept {
+    if (readFd_ >= 0) ::close(readFd_);
+    if (writeFd_ >= 0) ::close(writeFd_);
+    readFd_ = -1;
+    writeFd_ = -1;
+    pending_ = 0;
+}
+
+#else
+
+bool SplicePipe::supported() noexcept {
+    return false;
+}
+
+bool SplicePipe::open() noexcept {
+    return false;
+}
+
+std::size_t SplicePipe::fill(int, asio::error_code& ec) noexcept {
+    ec = asio::error::operation_not_supported;
+    return 0;
+}
+
+std::size_t SplicePipe::drain(int, asio::error_code& ec) noexcept {
+    ec = asio::error::operation_not_supported;
+    return 0;
+}
+
+void SplicePipe::close() noexcept {}
+
+#endif
+
+} // namespace shakyline
@@ -1,17 +1,18 @@
 #include "shakyline/AnomalyEngine.hpp"
 #include "shakyline/Config.hpp"
 #include "shakyline/ControlServer.hpp"
-#include "shakyline/EventLoop.hpp"
 #include "shakyline/Logger.hpp"
 #include "shakyline/MetricsRegistry.hpp"
-#include "shakyline/ProxyServer.hpp"
-#include "shakyline/Scheduler.hpp"
-#include "shakyline/SessionManager.hpp"
+#include "shakyline/Shard.hpp"
+#include "shakyline/SpillStore.hpp"
 
 #include <csignal>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 using namespace shakyline;
 
@@ -32,10 +33,21 @@ namespace {
                   << "  --upstream HOST:PORT   Upstream target (default: 127.0.0.1:9000)\n"
                   << "  --control PORT         Control API port (default: 9090)\n"
                   << "  --seed NUMBER          Global RNG seed (default: random)\n"
+                  << "  --threads N            Event loop shards, 0 = one per core (default: 1)\n"
+                  << "  --accept-mode MODE     reuseport | balanced (default: reuseport)\n"
+                  << "  --io-backend NAME      auto | epoll | io_uring (default: auto)\n"
+                  << "  --delay-spill DIR      Spill delayed data past 2MB/direction to mmap'd\n"
+                  << "                         files in DIR (default: off)\n"
+                  << "  --delay-spill-mb N     Spill budget per loop thread (default: 256)\n"
+                  << "  --stall-timeout MS     Longest injected stall (default: 30000)\n"
+                  << "  --trace-dir DIR        Keep uploaded latency traces as mmap'd files\n"
+                  << "                         in DIR, reloaded at startup (default: memory)\n"
                   << "  --help                 Show this help\n\n"
                   << "Control API:\n"
                   << "  POST /profiles/{name}  Update anomaly profile\n"
                   << "  DELETE /profiles/{name} Delete profile\n"
+                  << "  POST /traces/{name}    Upload latency samples (µs, whitespace-separated)\n"
+                  << "  DELETE /traces/{name}  Delete latency trace\n"
                   << "  GET /sessions          List active sessions\n"
                   << "  GET /metrics           Prometheus metrics\n"
                   << "  GET /health            Health check\n\n"
@@ -43,6 +55,30 @@ namespace {
                   << "  " << prog << " --listen 0.0.0.0:8080 --upstream api.example.com:443\n";
     }
 
+    /// Check the requested backend against this build and the running kernel
+    /// Returns false if the proxy cannot start with the request
+    bool resolveIoBackend(IoBackend requested) {
+#ifdef SHAKYLINE_IO_URING
+        if (requested == IoBackend::Epoll) {
+            std::cerr << "This build uses io_uring; rebuild with "
+                      << "-DSHAKYLINE_IO_URING=OFF for epoll\n";
+            return false;
+        }
+        if (!EventLoop::ioUringSupported()) {
+            std::cerr << "Kernel does not support io_uring; use a build with "
+                      << "-DSHAKYLINE_IO_URING=OFF\n";
+            return false;
+        }
+#else
+        if (requested == IoBackend::IoUring) {
+            std::cerr << "Warning: built without io_uring "
+                      << (EventLoop::ioUringSupported() ? "" : "(and kernel lacks it) ")
+                      << "- falling back to " << EventLoop::backendName() << "\n";
+        }
+#endif
+        return true;
+    }
+
     bool parseHostPort(const std::string& arg, std::string& host, uint16_t& port) {
         auto pos = arg.find(':');
         if (pos == std::string::npos) {
@@ -78,6 +114,45 @@ int main(int argc, char* argv[]) {
         else if (arg == "--seed" && i + 1 < argc) {
             config.globalSeed = std::stoull(argv[++i]);
         }
+        else if (arg == "--threads" && i + 1 < argc) {
+            config.ioThreads = std::stoul(argv[++i]);
+        }
+        else if (arg == "--accept-mode" && i + 1 < argc) {
+            std::string mode = argv[++i];
+            if (mode == "reuseport") {
+                config.acceptMode = AcceptMode::ReusePort;
+            } else if (mode == "balanced") {
+                config.acceptMode = AcceptMode::Balanced;
+            } else {
+                std::cerr << "Unknown accept mode: " << mode << "\n";
+                return 1;
+            }
+        }
+        else if (arg == "--delay-spill" && i + 1 < argc) {
+            config.delaySpillDir = argv[++i];
+        }
+        else if (arg == "--delay-spill-mb" && i + 1 < argc) {
+            config.delaySpillMaxBytes = std::stoull(argv[++i]) * 1024 * 1024;
+        }
+        else if (arg == "--trace-dir" && i + 1 < argc) {
+            config.traceDir = argv[++i];
+        }
+        else if (arg == "--stall-timeout" && i + 1 < argc) {
+            config.stallTimeout = std::chrono::milliseconds(std::stoul(argv[++i]));
+        }
+        else if (arg == "--io-backend" && i + 1 < argc) {
+            std::string backend = argv[++i];
+            if (backend == "auto") {
+                config.ioBackend = IoBackend::Auto;
+            } else if (backend == "epoll") {
+                config.ioBackend = IoBackend::Epoll;
+            } else if (backend == "io_uring") {
+                config.ioBackend = IoBackend::IoUring;
+            } else {
+                std::cerr << "Unknown I/O backend: " << backend << "\n";
+                return 1;
+            }
+        }
         else {
             std::cerr << "Unknown option: " << arg << "\n";
             printUsage(argv[0]);
@@ -85,6 +160,14 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (!resolveIoBackend(config.ioBackend)) {
+        return 1;
+    }
+
+    if (config.ioThreads == 0) {
+        config.ioThreads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
     // Generate random seed if not specified
     if (config.globalSeed == 0) {
         config.globalSeed = std::random_device{}();
@@ -98,7 +181,16 @@ int main(int argc, char* argv[]) {
               << "  Listen:   " << config.listenHost << ":" << config.listenPort << "\n"
               << "  Upstream: " << config.upstreamHost << ":" << config.upstreamPort << "\n"
               << "  Control:  http://localhost:" << config.controlPort << "\n"
-              << "  Seed:     " << config.globalSeed << "\n\n";
+              << "  Seed:     " << config.globalSeed << "\n"
+              << "  Threads:  " << config.ioThreads 
+              << (config.acceptMode == AcceptMode::Balanced ? " (balanced accept)" : "")
+              << "\n"
+              << "  I/O:      " << EventLoop::backendName() << "\n";
+    if (!config.delaySpillDir.empty()) {
+        std::cout << "  Spill:    " << config.delaySpillDir << " ("
+                  << config.delaySpillMaxBytes / (1024 * 1024) << " MB per thread)\n";
+    }
+    std::cout << "\n";
 
     // Setup signal handlers
     std::signal(SIGINT, signalHandler);
@@ -106,22 +198,43 @@ int main(int argc, char* argv[]) {
 
     try {
         // Create components
-        EventLoop eventLoop;
-        Scheduler scheduler(eventLoop.context());
         ConfigManager configManager;
         configManager.serverConfig() = config;
+        if (!config.traceDir.empty()) {
+            std::cout << "Loaded " << configManager.loadTraces() << " latency trace(s) from "
+                      << config.traceDir << "\n\n";
+        }
         
-        AnomalyEngine anomalyEngine(config.globalSeed);
+        AnomalyEngine anomalyEngine(config.globalSeed, config.stallTimeout);
+        SpillStore::configure(config.delaySpillDir, config.delaySpillMaxBytes);
+        if (!config.delaySpillDir.empty() && !SpillStore::supported()) {
+            std::cout << "Delay spill is not supported on this platform; delay queues stay in memory\n\n";
+        }
         
-        auto sessionManager = SessionManager::create(
-            eventLoop.context(), scheduler, anomalyEngine, configManager
-        );
+        // One shard per loop thread, each with its own acceptor and sessions
+        std::vector<std::unique_ptr<Shard>> shards;
+        std::vector<SessionManager::Ptr> sessionManagers;
+        for (std::size_t i = 0; i < config.ioThreads; ++i) {
+            shards.push_back(std::make_unique<Shard>(
+                i, config.ioThreads, anomalyEngine, configManager));
+            sessionManagers.push_back(shards.back()->sessions());
+        }
         
-        ProxyServer proxyServer(eventLoop.context(), sessionManager, config);
-        ControlServer controlServer(configManager, sessionManager, config.controlPort);
+        ControlServer controlServer(configManager, sessionManagers, config.controlPort);
+
+        // Balanced mode: shard 0 is the only acceptor and distributes sockets
+        bool balanced = config.acceptMode == AcceptMode::Balanced && shards.size() > 1;
+        if (balanced) {
+            shards.front()->setHandoffTargets(sessionManagers);
+        }
 
-        // Start servers
-        proxyServer.start();
+        // Start servers and run event loops (pinned only when sharded)
+        unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+        for (auto& shard : shards) {
+            int cpu = config.ioThreads > 1 
+                    ? static_cast<int>(shard->index() % cores) : -1;
+            shard->start(cpu, !balanced || shard->index() == 0);
+        }
         controlServer.start();
 
         std::cout << "Proxy started. Press Ctrl+C to stop.\n\n";
@@ -131,9 +244,6 @@ int main(int argc, char* argv[]) {
                   << "  curl -X POST http://localhost:" << config.controlPort 
                   << "/profiles/default -d '{\"latency_ms\":100}'\n\n";
 
-        // Run event loop
-        eventLoop.runInBackground();
-
         // Wait for shutdown signal
         while (!g_shutdown.load()) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -142,16 +252,15 @@ int main(int argc, char* argv[]) {
         std::cout << "\nShutting down...\n";
 
         // Graceful shutdown sequence
-        proxyServer.stop();
+        for (auto& shard : shards) shard->stopAccepting();
         controlServer.stop();
-        sessionManager->shutdownAll();
+        for (auto& shard : shards) shard->shutdownSessions();
         
         // Wait for drain (simple timeout)
         std::this_thread::sleep_for(std::chrono::seconds(2));
         
-        sessionManager->forceCloseAll();
-        eventLoop.stop();
-        eventLoop.join();
+        for (auto& shard : shards) shard->forceCloseSessions();
+        for (auto& shard : shards) shard->stop();
 
         // Dump black box log
         globalLogger().dumpBlackBox();